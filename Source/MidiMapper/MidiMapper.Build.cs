@@ -17,5 +17,8 @@ public class MidiMapper : ModuleRules
         {
             "UnrealMidi",
         });
+
+        // Plugin version stamp in benchmark reports
+        PrivateDependencyModuleNames.Add("Projects");
     }
 }
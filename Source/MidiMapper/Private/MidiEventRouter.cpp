@@ -10,10 +10,41 @@
 void UMidiEventRouter::Init(UMidiMappingManager* InManager)
 {
     Manager = InManager;
+    if (Manager)
+    {
+        Manager->OnMappingChanged().RemoveAll(this);
+        Manager->OnMappingChanged().AddUObject(this, &UMidiEventRouter::HandleMappingChanged);
+        Manager->OnBankChanged().RemoveAll(this);
+        Manager->OnBankChanged().AddUObject(this, &UMidiEventRouter::HandleBankChanged);
+    }
     UE_LOG(LogTemp, Log, TEXT("MidiEventRouter initialized"));
     TryBind();
 }
 
+void UMidiEventRouter::HandleMappingChanged(const FString& DeviceName, const FString& ControlKey)
+{
+    if (ControlKey.IsEmpty())
+        ClearModusStates(DeviceName + TEXT("|"));
+    else
+        ModusStates.Remove(DeviceName + TEXT("|") + ControlKey);
+}
+
+void UMidiEventRouter::HandleBankChanged(const FString& DeviceName, int32 NewBank, int32 OldBank)
+{
+    // Bank 0 stays active underneath every bank (and holds the shift buttons): only the bank left behind resets
+    if (OldBank != 0)
+        ClearModusStates(DeviceName + TEXT("|") + UMidiMappingManager::MakeBankKey(OldBank, FString()));
+}
+
+void UMidiEventRouter::ClearModusStates(const FString& Prefix)
+{
+    for (auto It = ModusStates.CreateIterator(); It; ++It)
+    {
+        if (It.Key().StartsWith(Prefix))
+            It.RemoveCurrent();
+    }
+}
+
 void UMidiEventRouter::TryBind()
 {
     if (GEngine)
@@ -76,6 +107,10 @@ void UMidiEventRouter::OnMidiValueReceived(const FMidiControlValue& Value)
     }
     LocalValue.Channel = Channel;
 
+    // Notes arrive with Type CC (bNote set); keys must say NOTE so "NOTE:36" matches
+    const bool bNote = LocalValue.bNote;
+    const EMidiMessageType KeyType = bNote ? EMidiMessageType::NoteOn : LocalValue.Type;
+
     if (ControlID < 0)
     {
         UE_LOG(LogTemp, Warning, TEXT("MidiEventRouter: couldn't parse control id from %s"), *LocalValue.Id);
@@ -98,7 +133,7 @@ void UMidiEventRouter::OnMidiValueReceived(const FMidiControlValue& Value)
         bLearning = false;
         FString Key = (LocalValue.Type == EMidiMessageType::PC)
             ? FString::Printf(TEXT("PC:%d:*"), Channel)
-            : UMidiMappingManager::MakeMidiMapKey(LocalValue.Type, ControlID);
+            : UMidiMappingManager::MakeMidiMapKey(KeyType, ControlID);
 
         OnLearn.Broadcast(DeviceName, Key);
         bSuppressNext = (Value.Type != EMidiMessageType::PC); // prevent the immediate next event from firing (lifting from a button)
@@ -123,6 +158,15 @@ void UMidiEventRouter::OnMidiValueReceived(const FMidiControlValue& Value)
     // --- Program Change ---
     if (LocalValue.Type == EMidiMessageType::PC)
     {
+        if (const FMidiDeviceMapping* Dev = Manager->GetDeviceMapping(DeviceName))
+        {
+            if (Dev->bProgramChangeSelectsBank && ControlID < Dev->Banks.Num())
+            {
+                Manager->SetActiveBank(DeviceName, ControlID);
+                return;
+            }
+        }
+
         const FString WildKey = FString::Printf(TEXT("PC:%d:*"), LocalValue.Channel);
 
         if (!Manager->GetMapping(DeviceName, WildKey, Action))
@@ -137,13 +181,432 @@ void UMidiEventRouter::OnMidiValueReceived(const FMidiControlValue& Value)
             DeviceName,
             ControlID,
             static_cast<float>(ControlID),
-            LocalValue.Type
+            LocalValue.Type,
+            LocalValue.Stages
         );
         return;
     }
 
     // --- fallback for CC, Note, etc ---
-    FString Key = UMidiMappingManager::MakeMidiMapKey(LocalValue.Type, ControlID);
-    if (Manager->GetMapping(DeviceName, Key, Action))
-        Manager->TriggerFunction(Action.ActionName.ToString(), DeviceName, LocalValue.ControlId, LocalValue.Value, LocalValue.Type);
-}
\ No newline at end of file
+    FString Key = UMidiMappingManager::MakeMidiMapKey(KeyType, ControlID);
+    // Combo members first: a completed combo swallows its trigger's own binding until release
+    const FMidiDeviceMapping* Dev = Manager->GetDeviceMapping(DeviceName);
+    if (Dev && Dev->ComboSlots.Num() > 0 && !LocalValue.bRelative)
+    {
+        if (const int32* Slot = Dev->ComboSlots.Find(Key))
+        {
+            if (StepCombos(DeviceName, *Dev, *Slot, LocalValue))
+                return;
+        }
+    }
+
+    int32 Bank = 0;
+    const FMidiMappedAction* Mapped = Manager->FindMapping(DeviceName, Key, &Bank);
+    if (!Mapped && bNote)
+    {
+        // Note bindings learned before keys carried the kind were saved as "CC:<note>"
+        Key = UMidiMappingManager::MakeMidiMapKey(EMidiMessageType::CC, ControlID);
+        Mapped = Manager->FindMapping(DeviceName, Key, &Bank);
+    }
+    if (Mapped)
+    {
+        const FString StateKey = DeviceName + TEXT("|") + UMidiMappingManager::MakeBankKey(Bank, Key);
+        if (LocalValue.bRelative && Mapped->EncoderMode != EMidiEncoderMode::Absolute)
+        {
+            AccumulateEncoder(StateKey, DeviceName, *Mapped, LocalValue);
+            return;
+        }
+        float Out;
+        if (StepModus(StateKey, *Mapped, LocalValue, Dev ? Dev->PickupEpoch : 0, Out))
+            Fire(StateKey, DeviceName, *Mapped, Out, LocalValue);
+    }
+}
+
+void UMidiEventRouter::Fire(const FString& StateKey, const FString& DeviceName, const FMidiMappedAction& Action, float Out, const FMidiControlValue& Value)
+{
+    if (Action.SelectBank >= 0)
+    {
+        SelectBank(StateKey, DeviceName, Action, Out);
+        return;
+    }
+    if (Action.MaxRateHz > 0.f || Action.bDeliverOnRelease)
+    {
+        Throttle(StateKey, DeviceName, Action, Out, Value);
+        return;
+    }
+    Manager->TriggerFunction(Action.ActionName.ToString(), DeviceName, Value.ControlId, Out, Value.Type, Value.Stages);
+}
+
+void UMidiEventRouter::Throttle(const FString& StateKey, const FString& DeviceName, const FMidiMappedAction& Action, float Out, const FMidiControlValue& Value)
+{
+    int32 Index;
+    if (const int32* Found = ThrottleIndex.Find(StateKey))
+    {
+        Index = *Found;
+    }
+    else
+    {
+        Index = Throttles.AddDefaulted();
+        ThrottleIndex.Add(StateKey, Index);
+    }
+
+    FThrottle& T = Throttles[Index];
+    T.ActionId = Action.ActionName.ToString();
+    T.Device = DeviceName;
+    T.Control = Value.ControlId;
+    T.Type = Value.Type;
+    if (!T.bPending)
+        T.Stages = Value.Stages;    // latency is measured from the oldest value the call stands for
+    T.Pending = Out;
+    T.bPending = true;
+
+    const double Now = FPlatformTime::Seconds();
+    if (Action.bDeliverOnRelease)
+    {
+        // Every change pushes the deadline out; only a control at rest gets through
+        Schedule(Index, Now + FMath::Max(Action.ReleaseIdle, 0.f));
+        return;
+    }
+
+    const double Interval = 1.0 / Action.MaxRateHz;
+    if (!T.bInWheel && Now - T.LastDelivered >= Interval)
+    {
+        DeliverThrottled(T, Now);       // leading edge
+        return;
+    }
+    if (!T.bInWheel)
+        Schedule(Index, T.LastDelivered + Interval);    // trailing edge
+}
+
+void UMidiEventRouter::Schedule(int32 Index, double Deadline)
+{
+    FThrottle& T = Throttles[Index];
+    T.Deadline = Deadline;
+    if (T.bInWheel)
+        return;     // only ever moves later; AdvanceWheel re-files it when its old bucket comes up
+
+    const int64 Tick = FMath::Max((int64)FMath::CeilToDouble(Deadline / WheelResolution), WheelCursor);
+    Wheel[Tick & (WheelSize - 1)].Add(Index);
+    T.bInWheel = true;
+
+    if (!WheelTickHandle.IsValid())
+        WheelTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UMidiEventRouter::AdvanceWheel));
+}
+
+void UMidiEventRouter::DeliverThrottled(FThrottle& T, double Now)
+{
+    T.bPending = false;
+    T.LastDelivered = Now;
+    if (Manager)
+        Manager->TriggerFunction(T.ActionId, T.Device, T.Control, T.Pending, T.Type, T.Stages);
+}
+
+bool UMidiEventRouter::AdvanceWheel(float)
+{
+    const double Now = FPlatformTime::Seconds();
+    const int64 NowTick = (int64)FMath::FloorToDouble(Now / WheelResolution);
+    if (WheelCursor < 0 || NowTick - WheelCursor >= WheelSize)
+        WheelCursor = NowTick - WheelSize + 1;      // first run or long hitch: one full turn covers every bucket
+
+    TArray<int32> Due;
+    while (WheelCursor <= NowTick)
+    {
+        Due.Reset();
+        Swap(Due, Wheel[WheelCursor++ & (WheelSize - 1)]);     // cursor first: re-filed entries land in a later bucket
+        for (const int32 Index : Due)
+        {
+            FThrottle& T = Throttles[Index];
+            T.bInWheel = false;
+            if (T.Deadline > Now)
+                Schedule(Index, T.Deadline);        // later turn, or pushed out since it was filed
+            else if (T.bPending)
+                DeliverThrottled(T, Now);
+        }
+    }
+    return true;
+}
+
+bool UMidiEventRouter::StepCombos(const FString& DeviceName, const FMidiDeviceMapping& Dev, int32 Slot, const FMidiControlValue& Value)
+{
+    FComboState& S = ComboStates.FindOrAdd(DeviceName);
+    if (S.Serial != Dev.CompileSerial)
+    {
+        S = FComboState();      // slots were renumbered
+        S.Serial = Dev.CompileSerial;
+    }
+
+    const uint64 Bit = uint64(1) << Slot;
+    const bool bWasPressed = (S.Pressed & Bit) != 0;
+    if (!bWasPressed && Value.Value >= 0.6f)
+        S.Pressed |= Bit;
+    else if (bWasPressed && Value.Value < 0.4f)
+        S.Pressed &= ~Bit;
+    const bool bPressed = (S.Pressed & Bit) != 0;
+
+    if (bPressed == bWasPressed)
+        return (S.Swallowed & Bit) != 0;
+
+    if (!bPressed)
+    {
+        if (!(S.Swallowed & Bit))
+            return false;
+        S.Swallowed &= ~Bit;
+
+        // Hold combos release with their trigger
+        if (const int32 Held = S.HeldCombo[Slot])
+        {
+            S.HeldCombo[Slot] = 0;
+            const FMidiCombo& C = Dev.Combos[Held - 1];
+            if (const FMidiMappedAction* Action = Dev.Banks.IsValidIndex(C.Bank) ? Dev.Banks[C.Bank].Find(C.Key) : nullptr)
+                Fire(DeviceName + TEXT("|") + UMidiMappingManager::MakeBankKey(C.Bank, C.Key), DeviceName, *Action, Action->OutputMin, Value);
+        }
+        return true;
+    }
+
+    const double Now = Value.Stages.Driver > 0.0 ? Value.Stages.Driver : FPlatformTime::Seconds();
+    S.PressTime[Slot] = Now;
+    if (!Dev.CombosByTrigger.IsValidIndex(Slot))
+        return false;
+
+    // Only the combos this control completes; the most specific match wins
+    int32 Best = INDEX_NONE;
+    const FMidiMappedAction* BestAction = nullptr;
+    for (const int32 Index : Dev.CombosByTrigger[Slot])
+    {
+        const FMidiCombo& C = Dev.Combos[Index];
+        if ((C.Bank != 0 && C.Bank != Dev.ActiveBank) || (Best != INDEX_NONE && C.Specificity <= Dev.Combos[Best].Specificity))
+            continue;
+
+        const FMidiMappedAction* Action = Dev.Banks[C.Bank].Find(C.Key);
+        if (!Action)
+            continue;
+
+        bool bMatch = (S.Pressed & C.HeldMask) == C.HeldMask;
+        if (C.Sequence.Num() > 0)
+        {
+            // Members pressed in order, all within the window
+            double Next = Now;
+            for (int32 i = C.Sequence.Num() - 2; i >= 0 && bMatch; --i)
+            {
+                const double T = S.PressTime[C.Sequence[i]];
+                bMatch = T > 0.0 && T < Next;
+                Next = T;
+            }
+            bMatch = bMatch && Now - Next <= Action->ComboWindow;
+        }
+
+        if (bMatch)
+        {
+            Best = Index;
+            BestAction = Action;
+        }
+    }
+    if (Best == INDEX_NONE)
+        return false;
+
+    const FMidiCombo& C = Dev.Combos[Best];
+    for (const int32 Member : C.Sequence)
+        S.PressTime[Member] = 0.0;      // a sequence fires once per performance
+    S.Swallowed |= Bit;
+
+    const FString StateKey = DeviceName + TEXT("|") + UMidiMappingManager::MakeBankKey(C.Bank, C.Key);
+    float Out = BestAction->OutputMax;
+    if (BestAction->ModusKind == EMidiModus::Hold)
+    {
+        S.HeldCombo[Slot] = Best + 1;
+    }
+    else if (BestAction->ModusKind == EMidiModus::Toggle)
+    {
+        FModusState& M = ModusStates.FindOrAdd(StateKey);
+        M.bLatched = !M.bLatched;
+        Out = M.bLatched ? BestAction->OutputMax : BestAction->OutputMin;
+    }
+    Fire(StateKey, DeviceName, *BestAction, Out, Value);
+    return true;
+}
+
+void UMidiEventRouter::SelectBank(const FString& StateKey, const FString& DeviceName, const FMidiMappedAction& Action, float Out)
+{
+    FModusState& S = ModusStates.FindOrAdd(StateKey);
+    switch (Action.ModusKind)
+    {
+        case EMidiModus::Hold:      // shift: back to where we were on release
+        case EMidiModus::Toggle:
+            if (Out == Action.OutputMax)
+            {
+                S.BankBefore = Manager->GetActiveBank(DeviceName);
+                Manager->SetActiveBank(DeviceName, Action.SelectBank);
+            }
+            else
+            {
+                Manager->SetActiveBank(DeviceName, S.BankBefore);
+            }
+            break;
+
+        default:
+            Manager->SetActiveBank(DeviceName, Action.SelectBank);
+            break;
+    }
+}
+
+void UMidiEventRouter::SetPickupTarget(const FString& DeviceName, const FString& ControlKey, float Target)
+{
+    FModusState& S = ModusStates.FindOrAdd(DeviceName + TEXT("|") + ControlKey);
+    if (const FMidiDeviceMapping* Dev = Manager ? Manager->GetDeviceMapping(DeviceName) : nullptr)
+        S.PickupEpoch = Dev->PickupEpoch;
+    S.PickupTarget = Target;
+    S.PickupPrev = -1.f;
+    S.bPickupWaiting = true;
+}
+
+bool UMidiEventRouter::PassPickup(FModusState& S, const FMidiMappedAction& Action, uint32 Epoch, float Out)
+{
+    if (S.PickupEpoch != Epoch)
+    {
+        // Re-armed: the software value is what the function reports, else what we last sent it
+        S.PickupEpoch = Epoch;
+        S.PickupPrev = -1.f;
+        float Current;
+        if (Manager->ReadFunctionValue(Action.ActionName.ToString(), Current))
+        {
+            S.PickupTarget = Current;
+            S.bPickupWaiting = true;
+        }
+        else
+        {
+            S.PickupTarget = S.Last;
+            S.bPickupWaiting = S.bHasLast;
+        }
+    }
+
+    if (S.bPickupWaiting)
+    {
+        const float Target = S.PickupTarget;
+        const bool bNear = FMath::Abs(Out - Target) <= Action.PickupThreshold;
+        const bool bCrossed = S.PickupPrev >= 0.f && (S.PickupPrev - Target) * (Out - Target) <= 0.f;
+        S.PickupPrev = Out;
+        if (!bNear && !bCrossed)
+            return false;
+        S.bPickupWaiting = false;
+    }
+
+    S.Last = Out;
+    S.bHasLast = true;
+    return true;
+}
+
+bool UMidiEventRouter::StepModus(const FString& StateKey, const FMidiMappedAction& Action, const FMidiControlValue& Value, uint32 PickupEpoch, float& OutValue)
+{
+    if (Action.ModusKind == EMidiModus::Absolute)
+    {
+        OutValue = Action.ApplyResponse(Value);
+        return !Action.bPickup || PassPickup(ModusStates.FindOrAdd(StateKey), Action, PickupEpoch, OutValue);
+    }
+
+    FModusState& S = ModusStates.FindOrAdd(StateKey);
+
+    if (Action.ModusKind == EMidiModus::Relative)
+    {
+        // The first value after a load or a mapping change is the starting point: it goes out as no change
+        const float Shaped = Action.ApplyResponse(Value);
+        const bool bFirst = !S.bHasLast;
+        OutValue = bFirst ? 0.f : Shaped - S.Last;
+        S.Last = Shaped;
+        S.bHasLast = true;
+        return bFirst || OutValue != 0.f;
+    }
+
+    // Buttons: press above 0.6, release below 0.4 so a fader or a bouncing pad doesn't chatter
+    const bool bWasPressed = S.bPressed;
+    if (!S.bPressed && Value.Value >= 0.6f)
+        S.bPressed = true;
+    else if (S.bPressed && Value.Value < 0.4f)
+        S.bPressed = false;
+    if (S.bPressed == bWasPressed)
+        return false;
+
+    switch (Action.ModusKind)
+    {
+        case EMidiModus::Trigger:
+            OutValue = Action.OutputMax;
+            return S.bPressed;
+
+        case EMidiModus::Toggle:
+            if (!S.bPressed)
+                return false;
+            S.bLatched = !S.bLatched;
+            OutValue = S.bLatched ? Action.OutputMax : Action.OutputMin;
+            return true;
+
+        case EMidiModus::Hold:
+            OutValue = S.bPressed ? Action.OutputMax : Action.OutputMin;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+void UMidiEventRouter::AccumulateEncoder(const FString& StateKey, const FString& DeviceName, const FMidiMappedAction& Action, const FMidiControlValue& Value)
+{
+    const int32 Raw = Value.RawBits == 7 ? (int32)Value.RawValue : FMath::RoundToInt(Value.Value * 127.f);
+    const int32 Ticks = UMidiMappingManager::DecodeEncoderTicks(Action.EncoderMode, Raw);
+    if (Ticks == 0)
+        return;
+
+    FEncoderAccum& A = Encoders.FindOrAdd(StateKey);
+
+    // Speed from the time between ticks (driver stamps when available), smoothed over a few ticks
+    const double Now = Value.Stages.Driver > 0.0 ? Value.Stages.Driver : FPlatformTime::Seconds();
+    const double Dt = A.LastTickTime > 0.0 ? Now - A.LastTickTime : 1.0;
+    A.LastTickTime = Now;
+    const float InstantTps = float(FMath::Abs(Ticks) / FMath::Max(Dt, 1e-3));
+    A.TicksPerSecond = Dt > 0.25 ? InstantTps : FMath::Lerp(A.TicksPerSecond, InstantTps, 0.3f);
+
+    const float Accel = 1.f + FMath::Max(0.f, Action.EncoderAcceleration) * (A.TicksPerSecond / 30.f);
+
+    if (!A.bPending)
+    {
+        A.ActionId = Action.ActionName.ToString();
+        A.Device = DeviceName;
+        A.Control = Value.ControlId;
+        A.Stages = Value.Stages;
+        A.PendingDelta = 0.f;
+        A.bPending = true;
+    }
+    A.PendingDelta += Ticks * Action.EncoderStep * Accel;
+
+    if (!EncoderTickHandle.IsValid())
+        EncoderTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UMidiEventRouter::FlushEncoders));
+}
+
+bool UMidiEventRouter::FlushEncoders(float)
+{
+    if (!Manager)
+        return true;
+
+    for (auto& Kvp : Encoders)
+    {
+        FEncoderAccum& A = Kvp.Value;
+        if (!A.bPending)
+            continue;
+        A.bPending = false;
+        Manager->TriggerFunction(A.ActionId, A.Device, A.Control, A.PendingDelta, EMidiMessageType::CC, A.Stages);
+    }
+    return true;
+}
+
+void UMidiEventRouter::BeginDestroy()
+{
+    if (EncoderTickHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(EncoderTickHandle);
+        EncoderTickHandle.Reset();
+    }
+    if (WheelTickHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(WheelTickHandle);
+        WheelTickHandle.Reset();
+    }
+    Super::BeginDestroy();
+}
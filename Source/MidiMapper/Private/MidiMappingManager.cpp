@@ -8,6 +8,12 @@
 #include "JsonObjectConverter.h"
 #include "MidiTypes.h"
 #include "Misc/ConfigCacheIni.h"
+#include "MidiLatency.h"
+#include "UnrealMidiSubsystem.h"
+#include "Engine/Engine.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_CYCLE_STAT(TEXT("Trigger"), STAT_MidiTrigger, STATGROUP_UnrealMidi);
 
 UMidiMappingManager* UMidiMappingManager::Get()
 {
@@ -54,8 +60,10 @@ void UMidiMappingManager::Initialize(const FString& InDeviceName, const FString&
 void UMidiMappingManager::RegisterMapping(const FString& InDeviceName, const FString& ControlKey, const FMidiMappedAction& Action)
 {
     FMidiDeviceMapping& DevMap = Mappings.FindOrAdd(InDeviceName);
-    DevMap.ControlMappings.Add(ControlKey, Action);
+    CompileAction(DevMap.ControlMappings.Add(ControlKey, Action));
     SaveMappings(InDeviceName, DevMap.RigName, DevMap.ControlMappings);
+    RebuildRouting(InDeviceName);
+    MappingChanged.Broadcast(InDeviceName, ControlKey);
 }
 
 bool UMidiMappingManager::GetMapping(const FString& InDeviceName, const FString& ControlKey, FMidiMappedAction& OutAction) const
@@ -71,6 +79,172 @@ bool UMidiMappingManager::GetMapping(const FString& InDeviceName, const FString&
     return false;
 }
 
+const FMidiMappedAction* UMidiMappingManager::FindMapping(const FString& InDeviceName, const FString& ControlKey, int32* OutBank) const
+{
+    const FMidiDeviceMapping* DevMap = Mappings.Find(InDeviceName);
+    if (!DevMap || DevMap->Banks.Num() == 0)
+        return nullptr;
+
+    const int32 Active = DevMap->ActiveBank;
+    const FMidiMappedAction* Found = Active > 0 ? DevMap->Banks[Active].Find(ControlKey) : nullptr;
+    if (Found)
+    {
+        if (OutBank) *OutBank = Active;
+        return Found;
+    }
+    if (OutBank) *OutBank = 0;
+    return DevMap->Banks[0].Find(ControlKey);
+}
+
+FString UMidiMappingManager::MakeBankKey(int32 Bank, const FString& ControlKey)
+{
+    return Bank > 0 ? FString::Printf(TEXT("B%d/%s"), Bank, *ControlKey) : ControlKey;
+}
+
+int32 UMidiMappingManager::SplitBankKey(const FString& Key, FString& OutControlKey)
+{
+    FString BankPart;
+    if (Key.StartsWith(TEXT("B")) && Key.Split(TEXT("/"), &BankPart, &OutControlKey) && BankPart.Len() > 1)
+        return FMath::Clamp(FCString::Atoi(*BankPart + 1), 0, 127);
+    OutControlKey = Key;
+    return 0;
+}
+
+void UMidiMappingManager::CompileBanks(FMidiDeviceMapping& Dev)
+{
+    Dev.Banks.Reset();
+    Dev.Banks.SetNum(1);
+    for (const auto& Kvp : Dev.ControlMappings)
+    {
+        FString ControlKey;
+        const int32 Bank = SplitBankKey(Kvp.Key, ControlKey);
+        if (Dev.Banks.Num() <= Bank)
+            Dev.Banks.SetNum(Bank + 1);
+        Dev.Banks[Bank].Add(ControlKey, Kvp.Value);
+    }
+    Dev.ActiveBank = FMath::Clamp(Dev.ActiveBank, 0, Dev.Banks.Num() - 1);
+    ++Dev.PickupEpoch;
+    CompileCombos(Dev);
+}
+
+FString UMidiMappingManager::MakeComboKey(const TArray<FString>& Members, bool bSequence)
+{
+    return (bSequence ? TEXT("SEQ:") : TEXT("COMBO:")) + FString::Join(Members, bSequence ? TEXT(">") : TEXT("+"));
+}
+
+void UMidiMappingManager::CompileCombos(FMidiDeviceMapping& Dev)
+{
+    Dev.ComboSlots.Reset();
+    Dev.Combos.Reset();
+    Dev.CombosByTrigger.Reset();
+    ++Dev.CompileSerial;
+
+    for (int32 Bank = 0; Bank < Dev.Banks.Num(); ++Bank)
+    {
+        for (const auto& Kvp : Dev.Banks[Bank])
+        {
+            FString Body = Kvp.Key;
+            const bool bSequence = Body.RemoveFromStart(TEXT("SEQ:"));
+            if (!bSequence && !Body.RemoveFromStart(TEXT("COMBO:")))
+                continue;
+
+            TArray<FString> Members;
+            Body.ParseIntoArray(Members, bSequence ? TEXT(">") : TEXT("+"), true);
+            if (Members.Num() < 2)
+                continue;
+
+            FMidiCombo Combo;
+            Combo.Key = Kvp.Key;
+            Combo.Bank = Bank;
+            Combo.Specificity = Members.Num();
+            bool bFits = true;
+            for (const FString& Member : Members)
+            {
+                const int32* Found = Dev.ComboSlots.Find(Member);
+                int32 Slot = Found ? *Found : INDEX_NONE;
+                if (!Found)
+                {
+                    if (Dev.ComboSlots.Num() >= 64)
+                    {
+                        UE_LOG(LogTemp, Warning, TEXT("MidiMapper: more than 64 combo controls, skipping %s"), *Kvp.Key);
+                        bFits = false;
+                        break;
+                    }
+                    Slot = Dev.ComboSlots.Add(Member, Dev.ComboSlots.Num());
+                }
+                Combo.Sequence.Add(Slot);
+            }
+            if (!bFits)
+                continue;
+
+            const int32 Trigger = Combo.Sequence.Last();
+            if (!bSequence)
+            {
+                for (int32 i = 0; i < Combo.Sequence.Num() - 1; ++i)
+                    Combo.HeldMask |= uint64(1) << Combo.Sequence[i];
+                Combo.Sequence.Reset();
+            }
+
+            if (Dev.CombosByTrigger.Num() <= Trigger)
+                Dev.CombosByTrigger.SetNum(Trigger + 1);
+            Dev.CombosByTrigger[Trigger].Add(Dev.Combos.Add(MoveTemp(Combo)));
+        }
+    }
+}
+
+void UMidiMappingManager::RebuildRouting(const FString& DeviceName)
+{
+    if (FMidiDeviceMapping* Dev = Mappings.Find(DeviceName))
+        CompileBanks(*Dev);
+    SyncRelativeControls(DeviceName);
+}
+
+bool UMidiMappingManager::SetActiveBank(const FString& DeviceName, int32 Bank)
+{
+    FMidiDeviceMapping* Dev = Mappings.Find(DeviceName);
+    if (!Dev || Bank < 0 || Bank >= Dev->Banks.Num())
+        return false;
+
+    const int32 Old = Dev->ActiveBank;
+    if (Old == Bank)
+        return true;
+
+    Dev->ActiveBank = Bank;
+    ++Dev->PickupEpoch;
+    SyncRelativeControls(DeviceName);   // encoders may be relative in one bank and absolute in another
+    UE_LOG(LogTemp, Log, TEXT("MIDI bank %d -> %d on %s"), Old, Bank, *DeviceName);
+    BankChanged.Broadcast(DeviceName, Bank, Old);
+    return true;
+}
+
+int32 UMidiMappingManager::GetActiveBank(const FString& DeviceName) const
+{
+    const FMidiDeviceMapping* Dev = Mappings.Find(DeviceName);
+    return Dev ? Dev->ActiveBank : 0;
+}
+
+int32 UMidiMappingManager::GetBankCount(const FString& DeviceName) const
+{
+    const FMidiDeviceMapping* Dev = Mappings.Find(DeviceName);
+    return Dev ? Dev->Banks.Num() : 0;
+}
+
+void UMidiMappingManager::ArmPickup(const FString& DeviceName)
+{
+    if (FMidiDeviceMapping* Dev = Mappings.Find(DeviceName))
+        ++Dev->PickupEpoch;
+}
+
+void UMidiMappingManager::SetProgramChangeSelectsBank(const FString& DeviceName, bool bEnable)
+{
+    FMidiDeviceMapping& Dev = Mappings.FindOrAdd(DeviceName);
+    if (Dev.bProgramChangeSelectsBank == bEnable)
+        return;
+
+    Dev.bProgramChangeSelectsBank = bEnable;
+    SaveMappings(DeviceName, Dev.RigName, Dev.ControlMappings);
+}
+
 void UMidiMappingManager::SaveMappings()
 {
     // Save all active device maps
@@ -90,6 +264,9 @@ void UMidiMappingManager::SaveMappings(
     const FString FilePath = GetMappingFilePath(InDeviceName, InRigName);
 
     TSharedRef<FJsonObject> RootObj = MakeShared<FJsonObject>();
+    RootObj->SetNumberField(TEXT("Version"), MappingFileVersion);
+    if (const FMidiDeviceMapping* Dev = Mappings.Find(InDeviceName))
+        RootObj->SetBoolField(TEXT("ProgramChangeSelectsBank"), Dev->bProgramChangeSelectsBank);
     for (const auto& Pair : InMappings)
     {
         TSharedPtr<FJsonObject> ActionObj = FJsonObjectConverter::UStructToJsonObject(Pair.Value);
@@ -132,6 +309,7 @@ void UMidiMappingManager::SaveMappingsToJson(const FString& FilePath, const FStr
     if (!Dev) return;
 
     TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetNumberField(TEXT("Version"), MappingFileVersion);
     Root->SetStringField(TEXT("DeviceName"), DeviceName);
     Root->SetStringField(TEXT("RigName"), Dev->RigName);
 
@@ -144,6 +322,7 @@ void UMidiMappingManager::SaveMappingsToJson(const FString& FilePath, const FStr
         MapObj->SetObjectField(Kvp.Key, ActionObj);
     }
     Root->SetObjectField(TEXT("Mappings"), MapObj);
+    Root->SetBoolField(TEXT("ProgramChangeSelectsBank"), Dev->bProgramChangeSelectsBank);
 
     FString OutStr;
     auto Writer = TJsonWriterFactory<>::Create(&OutStr);
@@ -164,6 +343,8 @@ void UMidiMappingManager::LoadMappingsFromJson(const FString& FilePath)
 
     const FString DeviceName = Root->GetStringField(TEXT("DeviceName"));
     const FString RigName = Root->GetStringField(TEXT("RigName"));
+    int32 FileVersion = 1;
+    Root->TryGetNumberField(TEXT("Version"), FileVersion);
 
     TMap<FString, FMidiMappedAction> NewMap;
 
@@ -178,6 +359,8 @@ void UMidiMappingManager::LoadMappingsFromJson(const FString& FilePath)
             {
                 if (FJsonObjectConverter::JsonObjectToUStruct((*ActionObj).ToSharedRef(), FMidiMappedAction::StaticStruct(), &Action))
                 {
+                    MigrateLegacyModus(Action, FileVersion);
+                    CompileAction(Action);
                     NewMap.Add(Pair.Key, Action);
                 }
             }
@@ -188,6 +371,10 @@ void UMidiMappingManager::LoadMappingsFromJson(const FString& FilePath)
     FMidiDeviceMapping& Dev = Mappings.FindOrAdd(DeviceName);
     Dev.RigName = RigName;
     Dev.ControlMappings = MoveTemp(NewMap);
+    Dev.bProgramChangeSelectsBank = false;
+    Root->TryGetBoolField(TEXT("ProgramChangeSelectsBank"), Dev.bProgramChangeSelectsBank);
+    RebuildRouting(DeviceName);
+    MappingChanged.Broadcast(DeviceName, FString());
 
     SaveLastUsedFile(DeviceName, FilePath);
 }
@@ -197,6 +384,7 @@ void UMidiMappingManager::LoadMappings(const FString& InDeviceName, const FStrin
     FMidiDeviceMapping& DevMap = Mappings.FindOrAdd(InDeviceName);
     DevMap.RigName = InRigName;
     DevMap.ControlMappings.Empty();
+    DevMap.bProgramChangeSelectsBank = false;
 
     FString JsonString;
     if (!FFileHelper::LoadFileToString(JsonString, *GetMappingFilePath(InDeviceName, InRigName)))
@@ -207,6 +395,11 @@ void UMidiMappingManager::LoadMappings(const FString& InDeviceName, const FStrin
 
     if (FJsonSerializer::Deserialize(Reader, RootObj) && RootObj.IsValid())
     {
+        int32 FileVersion = 1;
+        RootObj->TryGetNumberField(TEXT("Version"), FileVersion);
+        RootObj->TryGetBoolField(TEXT("ProgramChangeSelectsBank"), DevMap.bProgramChangeSelectsBank);
+
+        // Control keys map to objects; anything else at the root is file metadata
         for (const auto& Pair : RootObj->Values)
         {
             const TSharedPtr<FJsonObject>* ActionObj;
@@ -214,10 +407,14 @@ void UMidiMappingManager::LoadMappings(const FString& InDeviceName, const FStrin
             {
                 FMidiMappedAction Action;
                 FJsonObjectConverter::JsonObjectToUStruct(ActionObj->ToSharedRef(), &Action);
+                MigrateLegacyModus(Action, FileVersion);
+                CompileAction(Action);
                 DevMap.ControlMappings.Add(Pair.Key, Action);
             }
         }
     }
+    RebuildRouting(InDeviceName);
+    MappingChanged.Broadcast(InDeviceName, FString());
 }
 
 FString UMidiMappingManager::GetMappingFilePath(const FString& InDeviceName, const FString& InRigName) const
@@ -235,6 +432,8 @@ bool UMidiMappingManager::RemoveMapping(const FString& InDeviceName, const FStri
         if (bRemoved)
         {
             SaveMappings(InDeviceName, DevMap->RigName, DevMap->ControlMappings);
+            RebuildRouting(InDeviceName);
+            MappingChanged.Broadcast(InDeviceName, ControlKey);
             return true;
         }
     }
@@ -252,18 +451,161 @@ void UMidiMappingManager::DeactivateDevice(const FString& InDeviceName)
     {
         SaveMappings(InDeviceName, Existing->RigName, Existing->ControlMappings);
         Mappings.Remove(InDeviceName);
+        RebuildRouting(InDeviceName);
+        MappingChanged.Broadcast(InDeviceName, FString());
+    }
+}
+
+EMidiModus UMidiMappingManager::ParseModus(FName Modus)
+{
+    for (EMidiModus M : { EMidiModus::Trigger, EMidiModus::Toggle, EMidiModus::Hold, EMidiModus::Relative })
+    {
+        if (Modus == FName(ModusName(M)))     // FName compare is case-insensitive
+            return M;
+    }
+    return EMidiModus::Absolute;
+}
+
+void UMidiMappingManager::MigrateLegacyModus(FMidiMappedAction& Action, int32 FileVersion)
+{
+    // The learn window used to hard-code "Trigger", which the router ignored: every binding behaved as Absolute
+    if (FileVersion < MappingFileVersion && ParseModus(Action.Modus) == EMidiModus::Trigger)
+        Action.Modus = FName(ModusName(EMidiModus::Absolute));
+}
+
+const TCHAR* UMidiMappingManager::ModusName(EMidiModus Modus)
+{
+    switch (Modus)
+    {
+        case EMidiModus::Trigger:  return TEXT("Trigger");
+        case EMidiModus::Toggle:   return TEXT("Toggle");
+        case EMidiModus::Hold:     return TEXT("Hold");
+        case EMidiModus::Relative: return TEXT("Relative");
+        default:                   return TEXT("Absolute");
     }
 }
 
+void UMidiMappingManager::CompileAction(FMidiMappedAction& Action)
+{
+    Action.ModusKind = ParseModus(Action.Modus);
+    BakeResponseCurve(Action);
+}
+
+void UMidiMappingManager::BakeResponseCurve(FMidiMappedAction& Action)
+{
+    const bool bIdentity = Action.Curve == EMidiResponseCurve::Linear && !Action.bInvert
+        && Action.OutputMin == 0.f && Action.OutputMax == 1.f;
+    if (bIdentity)
+    {
+        Action.CurveLut.Reset();
+        return;
+    }
+
+    const UCurveFloat* Custom = nullptr;
+    if (Action.Curve == EMidiResponseCurve::Custom)
+    {
+        Custom = Action.CustomCurve.LoadSynchronous();
+        if (!Custom)
+        {
+            if (Action.CurveLut.Num() == 0)
+                UE_LOG(LogTemp, Warning, TEXT("[MidiMapper] Custom curve '%s' not found for %s; using linear"),
+                    *Action.CustomCurve.ToString(), *Action.ActionName.ToString());
+            else
+                return;     // keep the table saved with the mapping
+        }
+    }
+
+    const int32 N = Action.bHighResolution ? 16384 : 128;
+    const float K = FMath::Max(Action.CurveAmount, 0.01f);
+    Action.CurveLut.SetNumUninitialized(N);
+
+    for (int32 i = 0; i < N; ++i)
+    {
+        const float X = float(i) / float(N - 1);
+        float Y = X;
+        switch (Action.Curve)
+        {
+            case EMidiResponseCurve::Exponential: Y = FMath::Pow(X, K); break;
+            case EMidiResponseCurve::Logarithmic: Y = 1.f - FMath::Pow(1.f - X, K); break;
+            case EMidiResponseCurve::SCurve:
+                Y = X < 0.5f ? 0.5f * FMath::Pow(2.f * X, K) : 1.f - 0.5f * FMath::Pow(2.f - 2.f * X, K);
+                break;
+            case EMidiResponseCurve::Custom:      Y = Custom ? Custom->GetFloatValue(X) : X; break;
+            default: break;
+        }
+        if (Action.bInvert)
+            Y = 1.f - Y;
+        Action.CurveLut[i] = FMath::Lerp(Action.OutputMin, Action.OutputMax, Y);
+    }
+}
+
+int32 UMidiMappingManager::DecodeEncoderTicks(EMidiEncoderMode Mode, int32 Value0to127)
+{
+    const int32 V = Value0to127 & 0x7F;
+    switch (Mode)
+    {
+        case EMidiEncoderMode::TwosComplement: return V < 64 ? V : V - 128;
+        case EMidiEncoderMode::BinaryOffset:   return V - 64;
+        case EMidiEncoderMode::SignMagnitude:  return (V & 0x40) ? -(V & 0x3F) : (V & 0x3F);
+        default:                               return 0;
+    }
+}
+
+void UMidiMappingManager::SyncRelativeControls(const FString& DeviceName) const
+{
+    UUnrealMidiSubsystem* Midi = GEngine ? GEngine->GetEngineSubsystem<UUnrealMidiSubsystem>() : nullptr;
+    if (!Midi)
+        return;
+
+    Midi->ClearRelativeControls(DeviceName);
+    const FMidiDeviceMapping* Dev = Mappings.Find(DeviceName);
+    if (!Dev || Dev->Banks.Num() == 0)
+        return;
+
+    // What the router would resolve right now: the active bank over bank 0
+    auto Sync = [&](const TMap<FString, FMidiMappedAction>& Bank, const TMap<FString, FMidiMappedAction>* Override)
+    {
+        for (const auto& Kvp : Bank)
+        {
+            if (Kvp.Value.EncoderMode != EMidiEncoderMode::Absolute && !(Override && Override->Contains(Kvp.Key))
+                && Kvp.Key.StartsWith(TEXT("CC:")))
+                Midi->SetRelativeControl(DeviceName, FCString::Atoi(*Kvp.Key + 3), true);
+        }
+    };
+    const TMap<FString, FMidiMappedAction>* Active = Dev->ActiveBank > 0 ? &Dev->Banks[Dev->ActiveBank] : nullptr;
+    Sync(Dev->Banks[0], Active);
+    if (Active)
+        Sync(*Active, nullptr);
+}
+
 void UMidiMappingManager::RegisterFunction(const FString& Label, const FString& Id, FMidiFunction Func)
+{
+    RegisterFunction(Label, Id, Func, FMidiValueGetter());
+}
+
+void UMidiMappingManager::RegisterFunction(const FString& Label, const FString& Id, FMidiFunction Func, FMidiValueGetter Getter)
 {
     FMidiRegisteredFunction F;
     F.Label = Label;
     F.Id = Id;
     F.Callback = Func;
+    F.Getter = Getter;
     RegisteredFunctions.Add(F);
 }
 
+bool UMidiMappingManager::ReadFunctionValue(const FString& Id, float& OutValue) const
+{
+    for (const auto& F : RegisteredFunctions)
+    {
+        if (F.Id == Id && F.Getter.IsBound())
+        {
+            OutValue = F.Getter.Execute();
+            return true;
+        }
+    }
+    return false;
+}
+
 void UMidiMappingManager::TriggerFunction(const FString& Id, const FString& Device, int32 Control, float Value)
 {
     TriggerFunction(Id, Device, Control, Value, EMidiMessageType::CC);
@@ -271,6 +613,19 @@ void UMidiMappingManager::TriggerFunction(const FString& Id, const FString& Devi
 
 void UMidiMappingManager::TriggerFunction(const FString& Id, const FString& Device, int32 Control, float Value, EMidiMessageType Type)
 {
+    TriggerFunction(Id, Device, Control, Value, Type, FMidiStageTimes());
+}
+
+void UMidiMappingManager::TriggerFunction(const FString& Id, const FString& Device, int32 Control, float Value, EMidiMessageType Type,
+                                          const FMidiStageTimes& Stages)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MidiTrigger);
+    TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("UnrealMidi::Trigger", UnrealMidiChannel);
+
+    FMidiStageTimes Stamped = Stages;
+    Stamped.Trigger = FPlatformTime::Seconds();
+
+    bool bAny = false;
     for (const auto& F : RegisteredFunctions)
     {
         if (F.Id == Id)
@@ -282,9 +637,14 @@ void UMidiMappingManager::TriggerFunction(const FString& Id, const FString& Devi
             V.Value = Value;
             V.Type = Type;
             V.Id = F.Id;
+            V.Stages = Stamped;
             F.Callback.ExecuteIfBound(V);
+            bAny = true;
         }
     }
+
+    if (bAny)
+        FMidiLatencyTracker::Get().RecordTrigger(Device, Stamped);
 }
 
 void UMidiMappingManager::SaveAsConfig(const FString& FilePath)
@@ -296,11 +656,17 @@ void UMidiMappingManager::SaveAsConfig(const FString& FilePath)
     }
 
     TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetNumberField(TEXT("Version"), MappingFileVersion);
+
+    // Per-device settings sit in one object next to the device arrays
+    TSharedPtr<FJsonObject> PcSelectsBank = MakeShared<FJsonObject>();
+    Root->SetObjectField(TEXT("ProgramChangeSelectsBank"), PcSelectsBank);
 
     for (const auto& DevicePair : Mappings)
     {
         const FString& Device = DevicePair.Key;
         const FMidiDeviceMapping& Map = DevicePair.Value;
+        PcSelectsBank->SetBoolField(Device, Map.bProgramChangeSelectsBank);
 
         TArray<TSharedPtr<FJsonValue>> MappingsArray;
         for (const auto& ControlPair : Map.ControlMappings)
@@ -313,6 +679,23 @@ void UMidiMappingManager::SaveAsConfig(const FString& FilePath)
             Entry->SetStringField(TEXT("ActionName"), Action.ActionName.ToString());
             Entry->SetStringField(TEXT("TargetControl"), Action.TargetControl.ToString());
             Entry->SetStringField(TEXT("Modus"), Action.Modus.ToString());
+            Entry->SetNumberField(TEXT("EncoderMode"), (int32)Action.EncoderMode);
+            Entry->SetNumberField(TEXT("EncoderStep"), Action.EncoderStep);
+            Entry->SetNumberField(TEXT("EncoderAcceleration"), Action.EncoderAcceleration);
+            Entry->SetNumberField(TEXT("Curve"), (int32)Action.Curve);
+            Entry->SetNumberField(TEXT("CurveAmount"), Action.CurveAmount);
+            Entry->SetStringField(TEXT("CustomCurve"), Action.CustomCurve.ToString());
+            Entry->SetNumberField(TEXT("OutputMin"), Action.OutputMin);
+            Entry->SetNumberField(TEXT("OutputMax"), Action.OutputMax);
+            Entry->SetBoolField(TEXT("bInvert"), Action.bInvert);
+            Entry->SetBoolField(TEXT("bHighResolution"), Action.bHighResolution);
+            Entry->SetNumberField(TEXT("SelectBank"), Action.SelectBank);
+            Entry->SetNumberField(TEXT("ComboWindow"), Action.ComboWindow);
+            Entry->SetBoolField(TEXT("bPickup"), Action.bPickup);
+            Entry->SetNumberField(TEXT("PickupThreshold"), Action.PickupThreshold);
+            Entry->SetNumberField(TEXT("MaxRateHz"), Action.MaxRateHz);
+            Entry->SetBoolField(TEXT("bDeliverOnRelease"), Action.bDeliverOnRelease);
+            Entry->SetNumberField(TEXT("ReleaseIdle"), Action.ReleaseIdle);
             MappingsArray.Add(MakeShared<FJsonValueObject>(Entry));
         }
 
@@ -348,25 +731,73 @@ void UMidiMappingManager::ImportConfig(const FString& FilePath)
     if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
         return;
 
+    int32 FileVersion = 1;
+    Root->TryGetNumberField(TEXT("Version"), FileVersion);
+
+    const TSharedPtr<FJsonObject>* PcSelectsBank = nullptr;
+    Root->TryGetObjectField(TEXT("ProgramChangeSelectsBank"), PcSelectsBank);
+
+    // Entries go straight into the maps; each device is then rebuilt and saved once
     for (const auto& DevicePair : Root->Values)
     {
         const FString Device = DevicePair.Key;
         const TArray<TSharedPtr<FJsonValue>>* DeviceMappingArray;
         if (Root->TryGetArrayField(Device, DeviceMappingArray))
         {
+            FMidiDeviceMapping& DevMap = Mappings.FindOrAdd(Device);
+            if (PcSelectsBank && PcSelectsBank->IsValid())
+                (*PcSelectsBank)->TryGetBoolField(Device, DevMap.bProgramChangeSelectsBank);
+
             for (const auto& EntryValue : *DeviceMappingArray)
             {
                 const TSharedPtr<FJsonObject> Entry = EntryValue->AsObject();
                 if (!Entry.IsValid()) continue;
 
-                int32 ControlId = Entry->GetIntegerField(TEXT("ControlId"));
+                // Older files stored a bare control number
+                FString ControlKey;
+                if (!Entry->TryGetStringField(TEXT("ControlKey"), ControlKey))
+                {
+                    int32 ControlId = 0;
+                    if (!Entry->TryGetNumberField(TEXT("ControlId"), ControlId))
+                        continue;
+                    ControlKey = FString::Printf(TEXT("%d"), ControlId);
+                }
+
                 FMidiMappedAction Action;
                 Action.ActionName = FName(*Entry->GetStringField(TEXT("ActionName")));
                 Action.TargetControl = FName(*Entry->GetStringField(TEXT("TargetControl")));
                 Action.Modus = FName(*Entry->GetStringField(TEXT("Modus")));
-
-                RegisterOrUpdate(Device, FString::Printf(TEXT("%d"), ControlId), Action);
+                MigrateLegacyModus(Action, FileVersion);
+                int32 Mode = 0;
+                if (Entry->TryGetNumberField(TEXT("EncoderMode"), Mode))
+                    Action.EncoderMode = (EMidiEncoderMode)FMath::Clamp(Mode, 0, (int32)EMidiEncoderMode::SignMagnitude);
+                Entry->TryGetNumberField(TEXT("EncoderStep"), Action.EncoderStep);
+                Entry->TryGetNumberField(TEXT("EncoderAcceleration"), Action.EncoderAcceleration);
+                int32 Curve = 0;
+                if (Entry->TryGetNumberField(TEXT("Curve"), Curve))
+                    Action.Curve = (EMidiResponseCurve)FMath::Clamp(Curve, 0, (int32)EMidiResponseCurve::Custom);
+                Entry->TryGetNumberField(TEXT("CurveAmount"), Action.CurveAmount);
+                FString CurvePath;
+                if (Entry->TryGetStringField(TEXT("CustomCurve"), CurvePath))
+                    Action.CustomCurve = TSoftObjectPtr<UCurveFloat>(FSoftObjectPath(CurvePath));
+                Entry->TryGetNumberField(TEXT("OutputMin"), Action.OutputMin);
+                Entry->TryGetNumberField(TEXT("OutputMax"), Action.OutputMax);
+                Entry->TryGetBoolField(TEXT("bInvert"), Action.bInvert);
+                Entry->TryGetBoolField(TEXT("bHighResolution"), Action.bHighResolution);
+                Entry->TryGetNumberField(TEXT("SelectBank"), Action.SelectBank);
+                Entry->TryGetNumberField(TEXT("ComboWindow"), Action.ComboWindow);
+                Entry->TryGetBoolField(TEXT("bPickup"), Action.bPickup);
+                Entry->TryGetNumberField(TEXT("PickupThreshold"), Action.PickupThreshold);
+                Entry->TryGetNumberField(TEXT("MaxRateHz"), Action.MaxRateHz);
+                Entry->TryGetBoolField(TEXT("bDeliverOnRelease"), Action.bDeliverOnRelease);
+                Entry->TryGetNumberField(TEXT("ReleaseIdle"), Action.ReleaseIdle);
+
+                CompileAction(DevMap.ControlMappings.Add(ControlKey, MoveTemp(Action)));
             }
+
+            SaveMappings(Device, DevMap.RigName, DevMap.ControlMappings);
+            RebuildRouting(Device);
+            MappingChanged.Broadcast(Device, FString());
         }
     }
 
@@ -0,0 +1,32 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "MidiMappingManager.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Test-only seam: installs in-memory mappings on a private manager (nothing is saved), for MidiBench and
+ * the automation tests. Development builds only; game thread.
+ */
+struct FMidiMappingTestAccess
+{
+    static void AddMappings(UMidiMappingManager& Manager, const FString& Device, TMap<FString, FMidiMappedAction> Actions)
+    {
+        FMidiDeviceMapping& Map = Manager.Mappings.FindOrAdd(Device);
+        for (TPair<FString, FMidiMappedAction>& Kvp : Actions)
+        {
+            UMidiMappingManager::CompileAction(Kvp.Value);
+            Map.ControlMappings.Add(Kvp.Key, MoveTemp(Kvp.Value));
+        }
+        Manager.RebuildRouting(Device);
+    }
+
+    static void AddMapping(UMidiMappingManager& Manager, const FString& Device, const FString& ControlKey, FMidiMappedAction Action)
+    {
+        TMap<FString, FMidiMappedAction> One;
+        One.Add(ControlKey, MoveTemp(Action));
+        AddMappings(Manager, Device, MoveTemp(One));
+    }
+};
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,395 @@
+// MidiPipelineBenchmark.cpp
+//
+// "MidiBench [Events] [Controls]" times the hot path of a MIDI event:
+//   decode   FMidiInputDevice::HandleMessage (raw bytes -> FMidiControlValue)
+//   filter   UUnrealMidiSubsystem suppression + Schmitt filter
+//   dispatch queueing the value for the game thread (includes CC coalescing)
+//   route    UMidiEventRouter::OnMidiValueReceived (parse, lookup, trigger)
+//   trigger  UMidiMappingManager::TriggerFunction alone
+//   e2e      raw bytes -> registered function, including the game-thread hop
+// Each stage is measured per event (p50/p99/p99.9) together with heap allocations per event (from the
+// allocator's stat counters; "n/a" in builds without stats), and the report is written to
+// Saved/Profiling/MidiBench/ so plugin versions can be compared. The private stages are reached through
+// the test-only seams; OnMidiValue's other listeners are detached for the run, so the user's router and
+// Blueprints never see bench values.
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformProperties.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Engine/Engine.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#include "MidiInputDevice.h"
+#include "MidiInputKeys.h"
+#include "MidiPipelineTestAccess.h"
+#include "UnrealMidiSubsystem.h"
+#include "MidiEventRouter.h"
+#include "MidiMappingManager.h"
+#include "MidiMappingTestAccess.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace
+{
+    const TCHAR* BenchDevice = TEXT("MidiBench");
+    const TCHAR* BenchFunction = TEXT("MidiBench.Sink");
+
+    /**
+     * Allocator calls so far, from the counters the allocator keeps for "stat memory". Unset in builds
+     * without stats. They are process-wide, so other threads' allocations during a stage show up as noise.
+     */
+    TOptional<uint64> ReadAllocatorCalls()
+    {
+#if STATS
+        return uint64(FMalloc::TotalMallocCalls) + uint64(FMalloc::TotalReallocCalls);
+#else
+        return {};
+#endif
+    }
+
+    /** Exposes the raw decode entry point that RtMidi's callback normally drives */
+    class FMidiBenchDevice : public FMidiInputDevice
+    {
+    public:
+        using FMidiInputDevice::FMidiInputDevice;
+        using FMidiInputDevice::HandleMessage;
+    };
+
+    struct FStageResult
+    {
+        FString Name;
+        TArray<uint64> Cycles;
+        uint64 Allocs = 0;
+    };
+
+    double CyclesToNs(uint64 Cycles)
+    {
+        return FPlatformTime::ToSeconds64(Cycles) * 1e9;
+    }
+}
+
+class FMidiPipelineBenchmark
+{
+public:
+    FMidiPipelineBenchmark(int32 InNumEvents, int32 InNumControls)
+        : NumEvents(FMath::Max(InNumEvents, 1))
+        , NumControls(FMath::Clamp(InNumControls, 1, 128))
+    {}
+
+    bool Run(FOutputDevice& Ar)
+    {
+        Subsystem = GEngine ? GEngine->GetEngineSubsystem<UUnrealMidiSubsystem>() : nullptr;
+        if (!Subsystem)
+        {
+            Ar.Log(TEXT("MidiBench: UnrealMidi subsystem not available."));
+            return false;
+        }
+
+        // Building the workload certainly allocates: if the counters didn't move, this allocator doesn't keep them
+        const TOptional<uint64> CallsBefore = ReadAllocatorCalls();
+        BuildWorkload();
+        bCountsAllocs = CallsBefore.IsSet() && ReadAllocatorCalls().GetValue() != CallsBefore.GetValue();
+        if (!bCountsAllocs)
+            Ar.Log(TEXT("MidiBench: the allocator keeps no call counts (needs stats); allocations are reported as n/a."));
+        Setup();
+
+        // Warm maps, FName tables and caches before measuring
+        TimeEndToEnd(nullptr);
+        FMidiPipelineTestAccess::ResetControlState(*Subsystem, BenchDevice);
+
+        FStageResult Decode    { TEXT("decode") };
+        FStageResult Filter    { TEXT("filter") };
+        FStageResult Dispatch  { TEXT("dispatch") };
+        FStageResult Route     { TEXT("route") };
+        FStageResult Trigger   { TEXT("trigger") };
+        FStageResult EndToEnd  { TEXT("e2e") };
+
+        // Suppress per-event logging (e.g. TriggerFunction's "FOUND") so the log sink is not measured
+        const ELogVerbosity::Type PrevVerbosity = LogTemp.GetVerbosity();
+        LogTemp.SetVerbosity(ELogVerbosity::Warning);
+
+        TimeDecode(Decode);
+        TimeFilter(Filter);
+        TimeDispatch(Dispatch);
+        TimeRoute(Route);
+        TimeTrigger(Trigger);
+        FMidiPipelineTestAccess::ResetControlState(*Subsystem, BenchDevice);
+        TimeEndToEnd(&EndToEnd);
+
+        LogTemp.SetVerbosity(PrevVerbosity);
+
+        Teardown();
+
+        TArray<FStageResult*> Stages = { &Decode, &Filter, &Dispatch, &Route, &Trigger, &EndToEnd };
+        for (FStageResult* S : Stages)
+        {
+            S->Cycles.Sort();
+            Ar.Logf(TEXT("MidiBench %-8s n=%-7d p50=%8.0fns p99=%8.0fns p99.9=%8.0fns allocs/ev=%s"),
+                *S->Name, S->Cycles.Num(), Percentile(*S, 0.5), Percentile(*S, 0.99), Percentile(*S, 0.999),
+                bCountsAllocs ? *FString::Printf(TEXT("%.2f"), AllocsPerEvent(*S)) : TEXT("n/a"));
+        }
+
+        const FString Path = WriteReport(Stages);
+        Ar.Logf(TEXT("MidiBench: report written to %s"), *Path);
+        return true;
+    }
+
+private:
+    struct FRawMsg { uint8 Bytes[3]; };
+
+    void BuildWorkload()
+    {
+        // CC sweeps in 8-step increments between 8 and 119: every event clears the Schmitt
+        // thresholds and never looks like a digital edge, so all stages see every event
+        Raw.SetNumUninitialized(NumEvents);
+        for (int32 i = 0; i < NumEvents; ++i)
+        {
+            const int32 Control = i % NumControls;
+            const int32 Round = i / NumControls;
+            Raw[i].Bytes[0] = 0xB0;
+            Raw[i].Bytes[1] = uint8(Control);
+            Raw[i].Bytes[2] = uint8(8 + (Round * 8) % 112);
+        }
+
+        // Decoded copies for the stages that start after decode
+        FMidiBenchDevice Dev(BenchDevice, -1);
+        Decoded.Reset(NumEvents);
+        Dev.OnValue().AddLambda([this](const FMidiControlValue& V) { Decoded.Add(V); });
+        for (int32 i = 0; i < NumEvents; ++i)
+            Dev.HandleMessage(EventTime(i), Raw[i].Bytes, 3);
+    }
+
+    static double EventTime(int32 Index) { return Index * 0.001; } // 1 kHz event clock
+
+    void Setup()
+    {
+        // The bench holds the game thread for the whole run: detach OnMidiValue's listeners (the editor's
+        // router, Blueprints) and the input keys until Teardown, so bench values only reach the bench router
+        SavedOnMidiValue = Subsystem->OnMidiValue;
+        SavedOnMidiValueNative = Subsystem->OnMidiValueNative;
+        Subsystem->OnMidiValue.Clear();
+        Subsystem->OnMidiValueNative.Clear();
+        bKeysWereEnabled = FMidiInputKeys::Get().IsEnabled();
+        FMidiInputKeys::Get().SetEnabled(false);
+
+        // Private manager/router pair so nothing is persisted and the user's mappings stay untouched
+        Manager = NewObject<UMidiMappingManager>();
+        Manager->AddToRoot();
+        Router = NewObject<UMidiEventRouter>();
+        Router->AddToRoot();
+        Router->Init(Manager);
+
+        TMap<FString, FMidiMappedAction> Actions;
+        for (int32 c = 0; c < NumControls; ++c)
+        {
+            FMidiMappedAction Action;
+            Action.ActionName = BenchFunction;
+            Actions.Add(UMidiMappingManager::MakeMidiMapKey(EMidiMessageType::CC, c), Action);
+        }
+        FMidiMappingTestAccess::AddMappings(*Manager, BenchDevice, MoveTemp(Actions));
+
+        Manager->RegisterFunction(TEXT("MidiBench sink"), BenchFunction,
+            FMidiFunction::CreateLambda([this](const FMidiControlValue&) { ++NumTriggered; }));
+
+        Counters = &FMidiPipelineTestAccess::FindOrAddCounters(*Subsystem, BenchDevice);
+        Device = MakeShared<FMidiBenchDevice>(BenchDevice, -1);
+        FMidiPipelineTestAccess::BindInputDevice(*Subsystem, Device);
+        FMidiPipelineTestAccess::ResetControlState(*Subsystem, BenchDevice);
+    }
+
+    void Teardown()
+    {
+        FMidiPipelineTestAccess::ResetControlState(*Subsystem, BenchDevice);
+        Device.Reset();
+
+        Subsystem->OnMidiValue = SavedOnMidiValue;
+        Subsystem->OnMidiValueNative = SavedOnMidiValueNative;
+        FMidiInputKeys::Get().SetEnabled(bKeysWereEnabled);
+
+        Router->RemoveFromRoot();
+        Manager->RemoveFromRoot();
+        Router = nullptr;
+        Manager = nullptr;
+    }
+
+    template <typename FuncType>
+    void Measure(FStageResult& Out, int32 Num, FuncType&& Body)
+    {
+        Out.Cycles.Reset(Num);
+
+        const TOptional<uint64> AllocsBefore = ReadAllocatorCalls();
+        for (int32 i = 0; i < Num; ++i)
+        {
+            const uint64 T0 = FPlatformTime::Cycles64();
+            Body(i);
+            Out.Cycles.Add(FPlatformTime::Cycles64() - T0);
+        }
+        // Cycles.Reset reserved up front, so the Adds above never allocate. The counters restart when
+        // stats update, which only happens between frames; guard anyway.
+        const TOptional<uint64> AllocsAfter = ReadAllocatorCalls();
+        if (AllocsBefore.IsSet() && AllocsAfter.GetValue() >= AllocsBefore.GetValue())
+            Out.Allocs = AllocsAfter.GetValue() - AllocsBefore.GetValue();
+    }
+
+    void TimeDecode(FStageResult& Out)
+    {
+        FMidiBenchDevice Dev(BenchDevice, -1);
+        Measure(Out, NumEvents, [&](int32 i) { Dev.HandleMessage(EventTime(i), Raw[i].Bytes, 3); });
+    }
+
+    void TimeFilter(FStageResult& Out)
+    {
+        Passed.Reset(NumEvents);
+        FMidiPipelineTestAccess::ResetControlState(*Subsystem, BenchDevice);
+        Measure(Out, NumEvents, [&](int32 i)
+        {
+            FMidiControlValue V = Decoded[i]; // same copy HandleDeviceValue makes
+            if (FMidiPipelineTestAccess::Filter(*Subsystem, BenchDevice, V, *Counters))
+                Passed.Add(MoveTemp(V));
+        });
+    }
+
+    void TimeDispatch(FStageResult& Out)
+    {
+        Measure(Out, Passed.Num(), [&](int32 i) { FMidiPipelineTestAccess::Dispatch(*Subsystem, Passed[i], *Counters); });
+
+        // Drain the queued broadcasts (not timed; covered by route and e2e)
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+    }
+
+    void TimeRoute(FStageResult& Out)
+    {
+        Measure(Out, Passed.Num(), [&](int32 i) { Router->OnMidiValueReceived(Passed[i]); });
+    }
+
+    void TimeTrigger(FStageResult& Out)
+    {
+        const FString Device = BenchDevice;
+        const FString Function = BenchFunction;
+        Measure(Out, Passed.Num(), [&](int32 i)
+        {
+            Manager->TriggerFunction(Function, Device, Passed[i].ControlId, Passed[i].Value, EMidiMessageType::CC);
+        });
+    }
+
+    void TimeEndToEnd(FStageResult* Out)
+    {
+        FStageResult Scratch;
+        FStageResult& Result = Out ? *Out : Scratch;
+        const int32 Num = Out ? NumEvents : FMath::Min(NumEvents, 1024);
+
+        // Raw bytes in -> registered function called, including the game-thread hop
+        Measure(Result, Num, [&](int32 i)
+        {
+            Device->HandleMessage(EventTime(i), Raw[i].Bytes, 3);
+            FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+        });
+    }
+
+    static double AllocsPerEvent(const FStageResult& S)
+    {
+        return S.Cycles.Num() ? double(S.Allocs) / S.Cycles.Num() : 0.0;
+    }
+
+    static double Percentile(const FStageResult& S, double P)
+    {
+        if (S.Cycles.Num() == 0) return 0.0;
+        const int32 Index = FMath::Min(S.Cycles.Num() - 1, FMath::FloorToInt32(P * S.Cycles.Num()));
+        return CyclesToNs(S.Cycles[Index]);
+    }
+
+    FString WriteReport(const TArray<FStageResult*>& Stages) const
+    {
+        TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+
+        FString PluginVersion = TEXT("unknown");
+        if (TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("UnrealMidi")))
+            PluginVersion = Plugin->GetDescriptor().VersionName;
+
+        Root->SetStringField(TEXT("PluginVersion"), PluginVersion);
+        Root->SetStringField(TEXT("EngineVersion"), FEngineVersion::Current().ToString());
+        Root->SetStringField(TEXT("BuildConfiguration"), LexToString(FApp::GetBuildConfiguration()));
+        Root->SetStringField(TEXT("Platform"), FPlatformProperties::IniPlatformName());
+        Root->SetStringField(TEXT("Timestamp"), FDateTime::UtcNow().ToIso8601());
+        Root->SetNumberField(TEXT("Events"), NumEvents);
+        Root->SetNumberField(TEXT("Controls"), NumControls);
+        Root->SetNumberField(TEXT("TimerResolutionNs"), FPlatformTime::GetSecondsPerCycle64() * 1e9);
+        Root->SetNumberField(TEXT("Triggered"), double(NumTriggered));
+        Root->SetBoolField(TEXT("AllocsCounted"), bCountsAllocs);
+
+        TSharedRef<FJsonObject> StagesObj = MakeShared<FJsonObject>();
+        for (const FStageResult* S : Stages)
+        {
+            double Sum = 0.0;
+            for (uint64 C : S->Cycles) Sum += CyclesToNs(C);
+
+            TSharedRef<FJsonObject> Obj = MakeShared<FJsonObject>();
+            Obj->SetNumberField(TEXT("Samples"), S->Cycles.Num());
+            Obj->SetNumberField(TEXT("MeanNs"), S->Cycles.Num() ? Sum / S->Cycles.Num() : 0.0);
+            Obj->SetNumberField(TEXT("P50Ns"), Percentile(*S, 0.5));
+            Obj->SetNumberField(TEXT("P99Ns"), Percentile(*S, 0.99));
+            Obj->SetNumberField(TEXT("P999Ns"), Percentile(*S, 0.999));
+            Obj->SetNumberField(TEXT("MaxNs"), S->Cycles.Num() ? CyclesToNs(S->Cycles.Last()) : 0.0);
+            if (bCountsAllocs)
+                Obj->SetNumberField(TEXT("AllocsPerEvent"), AllocsPerEvent(*S));
+            else
+                Obj->SetStringField(TEXT("AllocsPerEvent"), TEXT("n/a"));
+            StagesObj->SetObjectField(S->Name, Obj);
+        }
+        Root->SetObjectField(TEXT("Stages"), StagesObj);
+
+        FString Out;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Out);
+        FJsonSerializer::Serialize(Root, Writer);
+
+        const FString Path = FPaths::ProjectSavedDir() / TEXT("Profiling/MidiBench") /
+            FString::Printf(TEXT("MidiBench_%s_%s.json"), *PluginVersion, *FDateTime::Now().ToString());
+        FFileHelper::SaveStringToFile(Out, *Path);
+        return Path;
+    }
+
+    int32 NumEvents;
+    int32 NumControls;
+
+    UUnrealMidiSubsystem* Subsystem = nullptr;
+    UMidiMappingManager* Manager = nullptr;
+    UMidiEventRouter* Router = nullptr;
+    TSharedPtr<FMidiBenchDevice> Device;
+    FMidiDeviceCounters* Counters = nullptr;
+
+    TArray<FRawMsg> Raw;
+    TArray<FMidiControlValue> Decoded;
+    TArray<FMidiControlValue> Passed;
+
+    FOnMidiValue SavedOnMidiValue;
+    FOnMidiValueNative SavedOnMidiValueNative;
+    bool bKeysWereEnabled = false;
+    bool bCountsAllocs = false;
+    uint64 NumTriggered = 0;
+};
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GMidiBenchCmd(
+    TEXT("MidiBench"),
+    TEXT("MidiBench [Events=100000] [Controls=64] - time decode/filter/dispatch/route/trigger, writes Saved/Profiling/MidiBench/*.json"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda(
+        [](const TArray<FString>& Args, UWorld*, FOutputDevice& Ar)
+        {
+            const int32 Events = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100000;
+            const int32 Controls = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 64;
+
+            FMidiPipelineBenchmark Bench(Events, Controls);
+            Bench.Run(Ar);
+        }));
+
+#endif // !UE_BUILD_SHIPPING
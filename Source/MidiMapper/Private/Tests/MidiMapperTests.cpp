@@ -0,0 +1,171 @@
+// MidiMapperTests.cpp
+//
+// Automation tests for learn mode and routing: a scripted input feeds the real pipeline, a private
+// manager/router pair (bound to OnMidiValue like the editor's) maps it, and the tests check which
+// registered functions were called. Mappings are installed in memory only, nothing is saved.
+//   UnrealEditor-Cmd <Project> -nullrhi -unattended -ExecCmds="Automation RunTests UnrealMidi.Mapper; Quit"
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Async/TaskGraphInterfaces.h"
+#include "Engine/Engine.h"
+#include "MidiEventRouter.h"
+#include "MidiMappingManager.h"
+#include "MidiMappingTestAccess.h"
+#include "MidiScriptedBackend.h"
+#include "UnrealMidiSubsystem.h"
+
+namespace MidiMapperTests
+{
+    constexpr EAutomationTestFlags Flags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+
+    /** Scripted input + private manager/router; Calls collects every registered function call */
+    class FRoutingFixture
+    {
+    public:
+        explicit FRoutingFixture(const FString& InDevice)
+            : Device(InDevice)
+        {
+            Midi = GEngine ? GEngine->GetEngineSubsystem<UUnrealMidiSubsystem>() : nullptr;
+            if (!Midi)
+                return;
+
+            Manager = NewObject<UMidiMappingManager>();
+            Manager->AddToRoot();
+            Router = NewObject<UMidiEventRouter>();
+            Router->AddToRoot();
+            Router->Init(Manager);
+
+            for (const TCHAR* Function : { TEXT("Test.Fader"), TEXT("Test.Pad"), TEXT("Test.Program") })
+            {
+                Manager->RegisterFunction(Function, Function,
+                    FMidiFunction::CreateLambda([this](const FMidiControlValue& V) { Calls.Add(V); }));
+            }
+
+            TUniquePtr<FMidiScriptedBackend> Script = MakeUnique<FMidiScriptedBackend>();
+            Backend = Script.Get();
+            if (!Midi->OpenInputDevice(Device, MoveTemp(Script)).IsValid())
+                Backend = nullptr;
+        }
+
+        ~FRoutingFixture()
+        {
+            if (!Midi)
+                return;
+
+            Midi->CloseInputDevice(Device);
+            Midi->OnMidiValue.RemoveDynamic(Router, &UMidiEventRouter::OnMidiValueReceived);
+            Router->RemoveFromRoot();
+            Manager->RemoveFromRoot();
+        }
+
+        bool IsValid() const { return Backend != nullptr; }
+
+        void Map(const FString& ControlKey, FName Function, FName Modus = NAME_None)
+        {
+            FMidiMappedAction Action;
+            Action.ActionName = Function;
+            Action.Modus = Modus;
+            FMidiMappingTestAccess::AddMapping(*Manager, Device, ControlKey, MoveTemp(Action));
+        }
+
+        /** Delivers one message stamped Time and runs the game-thread dispatch (OnMidiValue -> router) */
+        void Send(const TArray<uint8>& Bytes, double Time)
+        {
+            Backend->Inject(Bytes, Time);
+            FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+        }
+
+        const FString Device;
+        UMidiMappingManager* Manager = nullptr;
+        UMidiEventRouter* Router = nullptr;
+        TArray<FMidiControlValue> Calls;
+
+    private:
+        UUnrealMidiSubsystem* Midi = nullptr;
+        FMidiScriptedBackend* Backend = nullptr;
+    };
+}
+
+using namespace MidiMapperTests;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMidiMapperLearnTest, "UnrealMidi.Mapper.Learn", MidiMapperTests::Flags)
+bool FMidiMapperLearnTest::RunTest(const FString& Parameters)
+{
+    FRoutingFixture F(TEXT("UnrealMidiTest Learn"));
+    if (!TestTrue(TEXT("Scripted input opened"), F.IsValid()))
+        return false;
+
+    TArray<TPair<FString, FString>> Learned;
+    F.Router->OnMidiLearn().AddLambda([&Learned](FString DeviceName, FString ControlKey)
+    {
+        Learned.Emplace(DeviceName, ControlKey);
+    });
+
+    // Armed for another device: input from this one is ignored
+    F.Router->ArmLearnOnce(TEXT("UnrealMidiTest Other"));
+    F.Send({ 0xB0, 20, 100 }, 1.0);
+    TestEqual(TEXT("Nothing learned from the wrong device"), Learned.Num(), 0);
+    TestTrue(TEXT("Still learning"), F.Router->IsLearning());
+    F.Router->CancelLearning();
+
+    F.Router->ArmLearnOnce(F.Device);
+    F.Send({ 0xB0, 20, 90 }, 1.2);
+    if (!TestEqual(TEXT("One control learned"), Learned.Num(), 1))
+        return false;
+    TestEqual(TEXT("Device"), Learned[0].Key, F.Device);
+    TestEqual(TEXT("Key"), Learned[0].Value, FString(TEXT("CC:20")));
+    TestFalse(TEXT("Learning ends after one control"), F.Router->IsLearning());
+
+    // The learned control's next event is swallowed (the tail of the gesture), then it routes
+    F.Map(TEXT("CC:20"), TEXT("Test.Fader"));
+    F.Send({ 0xB0, 20, 50 }, 1.4);
+    TestEqual(TEXT("Event after learning is suppressed"), F.Calls.Num(), 0);
+    F.Send({ 0xB0, 20, 30 }, 1.6);
+    if (TestEqual(TEXT("Then the mapping fires"), F.Calls.Num(), 1))
+        TestEqual(TEXT("Value"), F.Calls[0].Value, 30.f / 127.f, KINDA_SMALL_NUMBER);
+
+    // Notes learn as NOTE:<n>, the key combos and mappings use
+    F.Router->ArmLearnOnce(F.Device);
+    F.Send({ 0x90, 36, 100 }, 2.0);
+    if (TestEqual(TEXT("Note learned"), Learned.Num(), 2))
+        TestEqual(TEXT("Note key"), Learned[1].Value, FString(TEXT("NOTE:36")));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMidiMapperRoutingTest, "UnrealMidi.Mapper.Routing", MidiMapperTests::Flags)
+bool FMidiMapperRoutingTest::RunTest(const FString& Parameters)
+{
+    FRoutingFixture F(TEXT("UnrealMidiTest Routing"));
+    if (!TestTrue(TEXT("Scripted input opened"), F.IsValid()))
+        return false;
+
+    F.Map(TEXT("CC:7"), TEXT("Test.Fader"));
+    F.Map(TEXT("NOTE:36"), TEXT("Test.Pad"), TEXT("Trigger"));
+    F.Map(TEXT("PC:1:*"), TEXT("Test.Program"));
+
+    F.Send({ 0xB0, 7, 64 }, 1.0);      // absolute: the value passes through
+    F.Send({ 0x90, 36, 100 }, 1.2);    // trigger: fires on the press with OutputMax
+    F.Send({ 0x80, 36, 64 }, 1.4);     // ... and not on the release, whatever its velocity
+    F.Send({ 0xC0, 9 }, 1.6);          // program changes forward the program number
+    F.Send({ 0xB0, 8, 64 }, 1.8);      // unmapped
+
+    if (!TestEqual(TEXT("Function calls"), F.Calls.Num(), 3))
+        return false;
+
+    TestEqual(TEXT("Fader function"), F.Calls[0].Id, FString(TEXT("Test.Fader")));
+    TestEqual(TEXT("Fader value"), F.Calls[0].Value, 64.f / 127.f, KINDA_SMALL_NUMBER);
+    TestEqual(TEXT("Fader control"), F.Calls[0].ControlId, 7);
+
+    TestEqual(TEXT("Pad function"), F.Calls[1].Id, FString(TEXT("Test.Pad")));
+    TestEqual(TEXT("Pad value"), F.Calls[1].Value, 1.f);
+
+    TestEqual(TEXT("Program function"), F.Calls[2].Id, FString(TEXT("Test.Program")));
+    TestEqual(TEXT("Program number"), F.Calls[2].Value, 9.f);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -3,6 +3,7 @@
 #include "MidiTypes.h"
 #include "UObject/NoExportTypes.h"
 #include "MidiMappingManager.h"
+#include "Containers/Ticker.h"
 #include "MidiEventRouter.generated.h"
 
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnMidiLearnSignature, FString /*DeviceName*/, FString /*ControlKey*/);
@@ -35,7 +36,15 @@ public:
         MidiActionDelegate.Broadcast(ActionName, Value);
     }
 
+    virtual void BeginDestroy() override;
+
     void TryBind();              // attempt immediate bind
+
+    /**
+     * Pickup mappings hold values back until the control reaches Target (output units). ControlKey as in
+     * the mapping file ("CC:7", "B2/CC:7"); use it when the rig value changes outside MIDI.
+     */
+    void SetPickupTarget(const FString& DeviceName, const FString& ControlKey, float Target);
     FOnLearningCancelled OnLearningCancelled;
 
 private:
@@ -44,6 +53,11 @@ private:
 
     void BindAfterEngineInit();  // deferred bind
 
+    // Latched Modus state must not outlive the mapping (or the bank) it was built for
+    void HandleMappingChanged(const FString& DeviceName, const FString& ControlKey);
+    void HandleBankChanged(const FString& DeviceName, int32 NewBank, int32 OldBank);
+    void ClearModusStates(const FString& Prefix);
+
     bool bLearning = false;
     bool bSuppressNext = false;
     int32 LastLearnedControl = -1;
@@ -52,4 +66,82 @@ private:
 
     FOnMidiAction MidiActionDelegate;
 
+    // Relative encoders: ticks of one frame are summed and triggered once from the ticker
+    struct FEncoderAccum
+    {
+        FString ActionId;
+        FString Device;
+        int32 Control = -1;
+        float PendingDelta = 0.f;
+        bool bPending = false;
+        double LastTickTime = 0.0;
+        float TicksPerSecond = 0.f;     // smoothed turning speed
+        FMidiStageTimes Stages;         // of the first tick in the batch
+    };
+
+    // Modus state per mapping; only transitions reach TriggerFunction
+    struct FModusState
+    {
+        bool bPressed = false;
+        bool bLatched = false;          // Toggle
+        bool bHasLast = false;          // Relative
+        float Last = 0.f;               // Relative; with pickup, the last value sent
+        int32 BankBefore = 0;           // bank selectors in Hold/Toggle
+
+        // Pickup (Absolute + bPickup)
+        uint32 PickupEpoch = 0;         // FMidiDeviceMapping::PickupEpoch this state was armed for
+        bool bPickupWaiting = false;
+        float PickupTarget = 0.f;
+        float PickupPrev = -1.f;        // previous held-back value, for crossing detection
+    };
+    bool StepModus(const FString& StateKey, const FMidiMappedAction& Action, const FMidiControlValue& Value, uint32 PickupEpoch, float& OutValue);
+    bool PassPickup(FModusState& S, const FMidiMappedAction& Action, uint32 Epoch, float Out);
+    void SelectBank(const FString& StateKey, const FString& DeviceName, const FMidiMappedAction& Action, float Out);
+    void Fire(const FString& StateKey, const FString& DeviceName, const FMidiMappedAction& Action, float Out, const FMidiControlValue& Value);
+
+    // Combos: pressed bits per device, indexed by FMidiDeviceMapping::ComboSlots
+    struct FComboState
+    {
+        uint32 Serial = 0;              // FMidiDeviceMapping::CompileSerial the slots belong to
+        uint64 Pressed = 0;
+        uint64 Swallowed = 0;           // triggers of a fired combo: their own binding sees nothing until release
+        double PressTime[64] = {};      // SEQ matching
+        int32 HeldCombo[64] = {};       // Hold combo fired by this trigger, +1
+    };
+    bool StepCombos(const FString& DeviceName, const FMidiDeviceMapping& Dev, int32 Slot, const FMidiControlValue& Value);
+    TMap<FString, FComboState> ComboStates;  // by device
+
+    // Throttled delivery (MaxRateHz / bDeliverOnRelease): latest value parked, released by a timer wheel
+    struct FThrottle
+    {
+        FString ActionId;
+        FString Device;
+        int32 Control = -1;
+        EMidiMessageType Type = EMidiMessageType::CC;
+        float Pending = 0.f;
+        FMidiStageTimes Stages;
+        bool bPending = false;
+        bool bInWheel = false;
+        double Deadline = 0.0;
+        double LastDelivered = -1.0;
+    };
+    void Throttle(const FString& StateKey, const FString& DeviceName, const FMidiMappedAction& Action, float Out, const FMidiControlValue& Value);
+    void Schedule(int32 Index, double Deadline);
+    void DeliverThrottled(FThrottle& T, double Now);
+    bool AdvanceWheel(float DeltaTime);
+
+    static constexpr int32 WheelSize = 256;             // power of two
+    static constexpr double WheelResolution = 0.004;    // seconds per bucket; ~1 s per turn
+    TArray<FThrottle> Throttles;
+    TMap<FString, int32> ThrottleIndex;                 // state key -> Throttles
+    TArray<int32> Wheel[WheelSize];
+    int64 WheelCursor = -1;                             // next bucket tick to process
+    FTSTicker::FDelegateHandle WheelTickHandle;
+    TMap<FString, FModusState> ModusStates;  // "Device|CC:n", "Device|B2/CC:n"
+
+    void AccumulateEncoder(const FString& StateKey, const FString& DeviceName, const FMidiMappedAction& Action, const FMidiControlValue& Value);
+    bool FlushEncoders(float DeltaTime);
+    TMap<FString, FEncoderAccum> Encoders;   // same keys as ModusStates
+    FTSTicker::FDelegateHandle EncoderTickHandle;
+
 };
@@ -2,11 +2,16 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "MidiTypes.h"
+#include "Curves/CurveFloat.h"
 #include "MidiMappingManager.generated.h"
 
 // Registered externally callable functions
 //DECLARE_DELEGATE_FourParams(FMidiFunction, const FString& /*Device*/, int32 /*Control*/, float /*Value*/, const FString& /*FunctionId*/);
 DECLARE_DELEGATE_OneParam(FMidiFunction, const FMidiControlValue&);
+/** Optional: current value of what a function drives, so pickup knows where the software is */
+DECLARE_DELEGATE_RetVal(float, FMidiValueGetter);
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnMidiBankChanged, const FString& /*DeviceName*/, int32 /*NewBank*/, int32 /*OldBank*/);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnMidiMappingChanged, const FString& /*DeviceName*/, const FString& /*ControlKey, empty = all*/);
 
 USTRUCT()
 struct FMidiRegisteredFunction
@@ -16,6 +21,39 @@ struct FMidiRegisteredFunction
     FString Label;
     FString Id;
     FMidiFunction Callback;
+    FMidiValueGetter Getter;
+};
+
+/** How a CC mapping reads its value; the relative modes are the common endless-encoder encodings */
+UENUM(BlueprintType)
+enum class EMidiEncoderMode : uint8
+{
+    Absolute,           // 0..127 position (default)
+    TwosComplement,     // 1..63 = +1..+63, 127..65 = -1..-63
+    BinaryOffset,       // 65..127 = +1..+63, 63..1 = -1..-63 (64 = no move)
+    SignMagnitude       // 1..63 = +1..+63, 65..127 = -1..-63 (bit 6 = sign)
+};
+
+/** What the router does with a mapped control's values (FMidiMappedAction::Modus by name) */
+UENUM(BlueprintType)
+enum class EMidiModus : uint8
+{
+    Absolute,   // every value passes through (faders, knobs)
+    Trigger,    // fires once per press
+    Toggle,     // each press flips on/off, fires the new state
+    Hold,       // fires 1 on press and 0 on release
+    Relative    // fires the change since the previous value
+};
+
+/** Response curve applied to absolute CC / note values before they reach the mapped function */
+UENUM(BlueprintType)
+enum class EMidiResponseCurve : uint8
+{
+    Linear,
+    Exponential,    // x^Amount: fine control at the low end
+    Logarithmic,    // 1-(1-x)^Amount: fine control at the high end
+    SCurve,         // flat at both ends, steep in the middle
+    Custom          // CustomCurve, sampled over 0..1
 };
 
 USTRUCT(BlueprintType)
@@ -29,8 +67,108 @@ struct FMidiMappedAction
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI")
     FName TargetControl;
 
+    /** "Absolute", "Trigger", "Toggle", "Hold" or "Relative" (see EMidiModus); None = Absolute */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI")
     FName Modus;
+
+    /** Modus resolved by UMidiMappingManager::CompileAction so the router doesn't compare names per event */
+    EMidiModus ModusKind = EMidiModus::Absolute;
+
+    /**
+     * Soft takeover for absolute controls: after a bank switch or load, values are held back until the
+     * hardware comes within PickupThreshold of (or crosses) the software value
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI|Response")
+    bool bPickup = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI|Response")
+    float PickupThreshold = 0.02f;
+
+    /** Delivery policy for slow functions: at most this many calls per second, the last value always arrives (0 = every value) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI|Delivery")
+    float MaxRateHz = 0.f;
+
+    /** Only call the function once the control has come to rest (no change for ReleaseIdle seconds) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI|Delivery")
+    bool bDeliverOnRelease = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI|Delivery")
+    float ReleaseIdle = 0.15f;
+
+    /** >= 0: this control switches the device to that bank instead of calling a function (Modus Hold = shift) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI|Bank")
+    int32 SelectBank = INDEX_NONE;
+
+    /** SEQ: mappings only: the whole sequence must be played within this many seconds */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI|Combo")
+    float ComboWindow = 0.5f;
+
+    /** Relative modes deliver the summed, accelerated delta of a frame's ticks instead of a position */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI|Encoder")
+    EMidiEncoderMode EncoderMode = EMidiEncoderMode::Absolute;
+
+    /** Value change per tick at slow speed */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI|Encoder")
+    float EncoderStep = 1.f / 127.f;
+
+    /** 0 = linear; otherwise the step grows by this factor per 30 ticks/s of turning speed */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI|Encoder")
+    float EncoderAcceleration = 0.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI|Response")
+    EMidiResponseCurve Curve = EMidiResponseCurve::Linear;
+
+    /** Exponent / steepness for the built-in curves */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI|Response")
+    float CurveAmount = 2.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI|Response")
+    TSoftObjectPtr<UCurveFloat> CustomCurve;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI|Response")
+    float OutputMin = 0.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI|Response")
+    float OutputMax = 1.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI|Response")
+    bool bInvert = false;
+
+    /** Bake 16384 entries instead of 128, for 14-bit / MIDI 2.0 controls */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI|Response")
+    bool bHighResolution = false;
+
+    /** Baked response (empty = identity). Saved with the mapping so custom curves work without the asset. */
+    UPROPERTY()
+    TArray<float> CurveLut;
+
+    /**
+     * One table load; falls back to the plain value when no table is baked.
+     * Notes carry the velocity in RawValue but are 0/1, so they map to the table's ends.
+     */
+    float ApplyResponse(const FMidiControlValue& V) const
+    {
+        const int32 N = CurveLut.Num();
+        if (N == 0)
+            return V.Value;
+
+        const int32 LutBits = N == 128 ? 7 : 14;
+        const int32 Index = V.bNote              ? FMath::RoundToInt(V.Value * (N - 1))
+                          : V.RawBits == LutBits ? (int32)V.RawValue
+                          : V.RawBits > LutBits  ? (int32)(V.RawValue >> (V.RawBits - LutBits))
+                          : FMath::RoundToInt(V.Value * (N - 1));
+        return CurveLut[FMath::Clamp(Index, 0, N - 1)];
+    }
+};
+
+/** One compiled COMBO:/SEQ: mapping; members are bit slots of FMidiDeviceMapping::ComboSlots */
+struct FMidiCombo
+{
+    FString Key;                // plain key in Banks[Bank]
+    int32 Bank = 0;
+    uint64 HeldMask = 0;        // COMBO: members that must be held when the trigger is pressed
+    TArray<int32> Sequence;     // SEQ: member slots in play order, trigger last
+    int32 Specificity = 0;      // member count; the most specific match wins
 };
 
 USTRUCT(BlueprintType)
@@ -38,7 +176,23 @@ struct FMidiDeviceMapping
 {
     GENERATED_BODY()
     FString RigName;
+
+    /** Persisted form: bank 0 uses plain keys ("CC:7"), other banks "B<n>/CC:7" (see MakeBankKey) */
     TMap<FString, FMidiMappedAction> ControlMappings;
+
+    /** Routing tables compiled from ControlMappings, one per bank, keyed by the plain control key */
+    TArray<TMap<FString, FMidiMappedAction>> Banks;
+    int32 ActiveBank = 0;
+
+    /** Program Change n selects bank n instead of going to a PC mapping */
+    bool bProgramChangeSelectsBank = false;
+
+    // Combo index (all banks): control key -> slot (max 64), and per trigger slot the combos it completes
+    TMap<FString, int32> ComboSlots;
+    TArray<FMidiCombo> Combos;
+    TArray<TArray<int32>> CombosByTrigger;
+    uint32 CompileSerial = 0;   // bumped on every compile so the router can drop stale slot state
+    uint32 PickupEpoch = 0;     // bumped on compile, bank switch and ArmPickup: pickup mappings re-arm
 };
 
 UCLASS()
@@ -54,6 +208,35 @@ public:
     void RegisterMapping(const FString& DeviceName, const FString& ControlKey, const FMidiMappedAction& Action);
     bool GetMapping(const FString& DeviceName, const FString& ControlKey, FMidiMappedAction& OutAction) const;
 
+    /**
+     * No-copy lookup for the per-event path (the action carries its baked curve table). Looks in the
+     * active bank first, then bank 0, so shared controls (the shift button) only need mapping once.
+     */
+    const FMidiMappedAction* FindMapping(const FString& DeviceName, const FString& ControlKey, int32* OutBank = nullptr) const;
+
+    // Banks: all are compiled up front; switching only moves the device's active index
+    static FString MakeBankKey(int32 Bank, const FString& ControlKey);
+    static int32 SplitBankKey(const FString& Key, FString& OutControlKey);
+
+    /**
+     * Combination keys: "COMBO:NOTE:36+CC:20" fires when CC 20 is pressed while Note 36 is held,
+     * "SEQ:NOTE:36>NOTE:38" when the members are pressed in order within ComboWindow.
+     */
+    static FString MakeComboKey(const TArray<FString>& Members, bool bSequence);
+    bool SetActiveBank(const FString& DeviceName, int32 Bank);
+    int32 GetActiveBank(const FString& DeviceName) const;
+    int32 GetBankCount(const FString& DeviceName) const;
+    void SetProgramChangeSelectsBank(const FString& DeviceName, bool bEnable);
+
+    /** Re-arms every pickup mapping of the device (e.g. after a preset changed the rig behind its back) */
+    void ArmPickup(const FString& DeviceName);
+
+    /** Game thread, after every switch; hook controller LEDs / HUD here */
+    FOnMidiBankChanged& OnBankChanged() { return BankChanged; }
+
+    /** After one mapping was added, changed or removed (its key, "B2/CC:7"), or a device's set was (re)loaded (empty key) */
+    FOnMidiMappingChanged& OnMappingChanged() { return MappingChanged; }
+
     void RegisterOrUpdate(const FString& DeviceName, const FString& ControlKey, const FMidiMappedAction& Action);
     bool RemoveMapping(const FString& DeviceName, const FString& ControlKey);
 
@@ -85,17 +268,49 @@ public:
         {
             Dev->ControlMappings.Empty();
             SaveMappings(InDeviceName, Dev->RigName, Dev->ControlMappings);
+            RebuildRouting(InDeviceName);
         }
     }
 
+    static EMidiModus ParseModus(FName Modus);
+    static const TCHAR* ModusName(EMidiModus Modus);
+
+    /** Written as "Version" into every mapping file; files without one predate the Modus state machines */
+    static constexpr int32 MappingFileVersion = 2;
+
+    /** Files older than MappingFileVersion stored "Trigger" for every row and meant Absolute */
+    static void MigrateLegacyModus(FMidiMappedAction& Action, int32 FileVersion);
+
+    /** Resolves what the router reads per event (ModusKind, the response table) after Action's settings changed */
+    static void CompileAction(FMidiMappedAction& Action);
+
+    /** (Re)builds Action.CurveLut from its curve settings; keeps a saved table if a custom curve can't load */
+    static void BakeResponseCurve(FMidiMappedAction& Action);
+
+    /** Signed tick count of one relative CC value (0 for Absolute) */
+    static int32 DecodeEncoderTicks(EMidiEncoderMode Mode, int32 Value0to127);
+
+    /** Tells UnrealMidi which CCs of a device are relative, so they bypass filtering and coalescing */
+    void SyncRelativeControls(const FString& DeviceName) const;
+
+    /** Recompiles the bank tables after ControlMappings changed, then re-syncs relative CCs */
+    void RebuildRouting(const FString& DeviceName);
+    static void CompileBanks(FMidiDeviceMapping& Dev);
+    static void CompileCombos(FMidiDeviceMapping& Dev);
+
     void ClearRegisteredFunctions();
     void UnregisterTopic(const FString& TopicPrefix);
 
     void RegisterFunction(const FString& Label, const FString& Id, FMidiFunction Func);
+    void RegisterFunction(const FString& Label, const FString& Id, FMidiFunction Func, FMidiValueGetter Getter);
+    bool ReadFunctionValue(const FString& Id, float& OutValue) const;
     const TArray<FMidiRegisteredFunction>& GetRegisteredFunctions() const { return RegisteredFunctions; }
 
     void TriggerFunction(const FString& Id, const FString& Device, int32 Control, float Value);
     void TriggerFunction(const FString& Id, const FString& Device, int32 Control, float Value, EMidiMessageType Type);
+    /** Router path: carries the event's stage stamps so the trigger latency is recorded */
+    void TriggerFunction(const FString& Id, const FString& Device, int32 Control, float Value, EMidiMessageType Type,
+                         const FMidiStageTimes& Stages);
 
     UFUNCTION(BlueprintCallable, Category="MIDI Mapping")
     void SaveAsConfig(const FString& FilePath);
@@ -116,6 +331,9 @@ public:
     }
 
 private:
+    // Test-only seam (MidiMappingTestAccess.h): transient mappings for MidiBench and the automation tests
+    friend struct FMidiMappingTestAccess;
+
     //FString DeviceName;
     //FString RigName;
     FString MappingFilePath;
@@ -129,4 +347,7 @@ private:
     UPROPERTY()
     TMap<FString, FMidiDeviceMapping> Mappings;
 
+    FOnMidiBankChanged BankChanged;
+    FOnMidiMappingChanged MappingChanged;
+
 };
@@ -42,6 +42,9 @@ void SMidiMappingWindow::Construct(const FArguments& InArgs)
 {
     ActiveWindow = SharedThis(this);
 
+    for (EMidiModus M : { EMidiModus::Absolute, EMidiModus::Trigger, EMidiModus::Toggle, EMidiModus::Hold, EMidiModus::Relative })
+        ModusOptions.Add(MakeShared<FString>(UMidiMappingManager::ModusName(M)));
+
     Rows.Empty();
     if (UMidiMappingManager* M = UMidiMappingManager::Get())
     {
@@ -50,7 +53,7 @@ void SMidiMappingWindow::Construct(const FArguments& InArgs)
             auto Row = MakeShared<FControlRow>();
             Row->ActionName = F.Label;
             Row->TargetControl = F.Id;
-            Row->Modus = TEXT("Trigger");
+            Row->Modus = TEXT("Absolute");
             Rows.Add(Row);
         }
     }
@@ -169,8 +172,9 @@ void SMidiMappingWindow::Construct(const FArguments& InArgs)
                         .OnGenerateRow(this, &SMidiMappingWindow::GenerateMappingRow)
                         .HeaderRow(
                             SNew(SHeaderRow)
-                            + SHeaderRow::Column("Control").DefaultLabel(FText::FromString("Control")).FillWidth(0.4f)
-                            + SHeaderRow::Column("Learn").DefaultLabel(FText::FromString("Learn")).FillWidth(0.3f)
+                            + SHeaderRow::Column("Control").DefaultLabel(FText::FromString("Control")).FillWidth(0.3f)
+                            + SHeaderRow::Column("Modus").DefaultLabel(FText::FromString("Modus")).FillWidth(0.15f)
+                            + SHeaderRow::Column("Learn").DefaultLabel(FText::FromString("Learn")).FillWidth(0.25f)
                             + SHeaderRow::Column("Current Mapping").DefaultLabel(FText::FromString("Current Mapping")).FillWidth(0.3f)
                         )
                 ]
@@ -179,6 +183,11 @@ void SMidiMappingWindow::Construct(const FArguments& InArgs)
     RefreshBindings();
     RefreshList();
 
+    if (UMidiMappingManager* M = UMidiMappingManager::Get())
+    {
+        M->OnBankChanged().AddSP(this, &SMidiMappingWindow::OnBankChanged);
+    }
+
     if (UMidiEventRouter* Router = FMidiMapperModule::GetRouter())
     {
         if (IsValid(Router))
@@ -196,6 +205,13 @@ void SMidiMappingWindow::Construct(const FArguments& InArgs)
     }
 }
 
+void SMidiMappingWindow::OnBankChanged(const FString& DeviceName, int32 NewBank, int32 OldBank)
+{
+    if (DeviceName != ActiveDeviceName) return;
+    RefreshBindings();
+    RefreshList();
+}
+
 void SMidiMappingWindow::SetActiveDevice(const FString& Device)
 {
     ActiveDeviceName = Device;
@@ -212,7 +228,7 @@ void SMidiMappingWindow::RefreshFunctions()
             auto Row = MakeShared<FControlRow>();
             Row->ActionName = F.Label;
             Row->TargetControl = F.Id;
-            Row->Modus = TEXT("Trigger");
+            Row->Modus = TEXT("Absolute");
             Rows.Add(Row);
         }
     }
@@ -235,14 +251,18 @@ void SMidiMappingWindow::RefreshBindings()
 
         for (auto& Row : Rows)
         {
-            Row->BoundControlKey;
             for (const auto& KVP : DeviceMap->ControlMappings)
             {
+                FString PlainKey;
+                if (UMidiMappingManager::SplitBankKey(KVP.Key, PlainKey) != DeviceMap->ActiveBank)
+                    continue;   // the window edits the active bank
+
                 const FMidiMappedAction& Action = KVP.Value;
                 if (Action.ActionName.ToString() == Row->ActionName &&
                     Action.TargetControl.ToString() == Row->TargetControl)
                 {
                     Row->BoundControlKey = KVP.Key;
+                    Row->Modus = UMidiMappingManager::ModusName(UMidiMappingManager::ParseModus(Action.Modus));
                     break;
                 }
             }
@@ -277,11 +297,13 @@ void SMidiMappingWindow::OnLearnedControl(FString DeviceName, FString ControlKey
     if (!Row.IsValid()) return;
 
     Row->bIsLearning = false;
-    Row->BoundControlKey = ControlKey;
     Row->bIsProgramChange = ControlKey.Contains(TEXT("PC:"));
 
     if (UMidiMappingManager* M = UMidiMappingManager::Get())
     {
+        ControlKey = UMidiMappingManager::MakeBankKey(M->GetActiveBank(ActiveDeviceName), ControlKey);
+        Row->BoundControlKey = ControlKey;
+
         FMidiMappedAction A;
         A.ActionName = FName(*Row->ActionName);
         A.TargetControl = FName(*Row->TargetControl);
@@ -297,6 +319,25 @@ void SMidiMappingWindow::OnLearnedControl(FString DeviceName, FString ControlKey
             Router->OnMidiLearn().RemoveAll(this);
 }
 
+void SMidiMappingWindow::SetRowModus(TSharedPtr<FControlRow> Row, const FString& NewModus)
+{
+    if (!Row.IsValid() || Row->Modus == NewModus) return;
+
+    Row->Modus = NewModus;
+    if (Row->BoundControlKey.IsEmpty()) return;
+
+    // Bound already: update the live mapping, keeping its curve/encoder settings
+    if (UMidiMappingManager* M = UMidiMappingManager::Get())
+    {
+        FMidiMappedAction A;
+        if (M->GetMapping(ActiveDeviceName, Row->BoundControlKey, A))
+        {
+            A.Modus = FName(*NewModus);
+            M->RegisterOrUpdate(ActiveDeviceName, Row->BoundControlKey, A);
+        }
+    }
+}
+
 FReply SMidiMappingWindow::OnUnbindClicked(TSharedPtr<FControlRow> Row)
 {
     SafeCancelLearning();
@@ -30,6 +30,8 @@ public:
     FReply OnUnbindClicked(TSharedPtr<FControlRow> Row);
 
     const TArray<TSharedPtr<FString>>& GetPCModes() const { return PCModes; }
+    const TArray<TSharedPtr<FString>>& GetModusOptions() const { return ModusOptions; }
+    void SetRowModus(TSharedPtr<FControlRow> Row, const FString& NewModus);
 
     FReply OnSaveMappingClicked();
     FReply OnLoadMappingClicked();
@@ -50,6 +52,7 @@ private:
     TSharedPtr<SComboBox<TSharedPtr<FString>>> DeviceCombo;
 
     TArray<TSharedPtr<FString>> PCModes;
+    TArray<TSharedPtr<FString>> ModusOptions;
 
     TSharedPtr<SListView<TSharedPtr<FControlRow>>> MappingListView;
 
@@ -59,6 +62,7 @@ private:
         TSharedPtr<FControlRow> InItem,
         const TSharedRef<STableViewBase>& OwnerTable);
     void OnLearnedControl(FString DeviceName, FString ControlKey, TSharedPtr<FControlRow> Row);
+    void OnBankChanged(const FString& DeviceName, int32 NewBank, int32 OldBank);
     FReply OnForgetAllClicked();
 
     void SafeCancelLearning();
@@ -137,6 +141,30 @@ public:
                         ]
                 ];
         }
+        else if (ColumnName == "Modus")
+        {
+            auto OwnerPinned = OwnerWindow.Pin();
+            if (!OwnerPinned.IsValid())
+                return SNullWidget::NullWidget;
+
+            return SNew(SBox).Padding(Padding)
+                [
+                    SNew(SComboBox<TSharedPtr<FString>>)
+                        .OptionsSource(&OwnerPinned->GetModusOptions())
+                        .OnSelectionChanged_Lambda([W = OwnerWindow, R = RowItem](TSharedPtr<FString> NewItem, ESelectInfo::Type)
+                            {
+                                if (auto P = W.Pin())
+                                    if (NewItem.IsValid()) P->SetRowModus(R, *NewItem);
+                            })
+                        .OnGenerateWidget_Lambda([](TSharedPtr<FString> Item)
+                            {
+                                return SNew(STextBlock).Text(FText::FromString(*Item));
+                            })
+                        [
+                            SNew(STextBlock).Text_Lambda([R = RowItem]() { return FText::FromString(R->Modus); })
+                        ]
+                ];
+        }
         else if (ColumnName == "Current Mapping")
         {
             return SNew(SBox).Padding(Padding)
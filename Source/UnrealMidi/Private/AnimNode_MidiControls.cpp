@@ -0,0 +1,78 @@
+#include "AnimNode_MidiControls.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "Engine/Engine.h"
+#include "UnrealMidiSubsystem.h"
+
+void FAnimNode_MidiControls::Initialize_AnyThread(const FAnimationInitializeContext& Context)
+{
+    FAnimNode_Base::Initialize_AnyThread(Context);
+    Source.Initialize(Context);
+
+    // Slots live as long as the subsystem, so this happens once per binding
+    UUnrealMidiSubsystem* Midi = GEngine ? GEngine->GetEngineSubsystem<UUnrealMidiSubsystem>() : nullptr;
+    for (FMidiAnimControlBinding& B : Bindings)
+    {
+        if (!B.Handle.IsValid() && Midi)
+            B.Handle = Midi->ResolveControl(B.ControlId);
+    }
+}
+
+void FAnimNode_MidiControls::CacheBones_AnyThread(const FAnimationCacheBonesContext& Context)
+{
+    Source.CacheBones(Context);
+
+    const FBoneContainer& RequiredBones = Context.AnimInstanceProxy->GetRequiredBones();
+    for (FMidiAnimControlBinding& B : Bindings)
+    {
+        if (B.Target != EMidiAnimTarget::Curve)
+            B.Bone.Initialize(RequiredBones);
+    }
+}
+
+void FAnimNode_MidiControls::Update_AnyThread(const FAnimationUpdateContext& Context)
+{
+    GetEvaluateGraphExposedInputs().Execute(Context);
+    Source.Update(Context);
+}
+
+void FAnimNode_MidiControls::Evaluate_AnyThread(FPoseContext& Output)
+{
+    Source.Evaluate(Output);
+
+    const FBoneContainer& RequiredBones = Output.Pose.GetBoneContainer();
+    for (const FMidiAnimControlBinding& B : Bindings)
+    {
+        float Raw = B.DefaultValue;
+        const float Value = B.Handle.Read(Raw) ? FMath::Lerp(B.OutputMin, B.OutputMax, Raw) : B.DefaultValue;
+
+        switch (B.Target)
+        {
+            case EMidiAnimTarget::Curve:
+                if (!B.CurveName.IsNone())
+                    Output.Curve.Set(B.CurveName, Value);
+                break;
+
+            case EMidiAnimTarget::BoneRotation:
+            case EMidiAnimTarget::BoneTranslation:
+            {
+                if (!B.Bone.IsValidToEvaluate(RequiredBones))
+                    break;
+
+                FTransform& Bone = Output.Pose[B.Bone.GetCompactPoseIndex(RequiredBones)];
+                if (B.Target == EMidiAnimTarget::BoneRotation)
+                    Bone.SetRotation(FQuat(B.Axis.GetSafeNormal(), FMath::DegreesToRadians(Value)) * Bone.GetRotation());
+                else
+                    Bone.AddToTranslation(B.Axis.GetSafeNormal() * Value);
+                break;
+            }
+        }
+    }
+}
+
+void FAnimNode_MidiControls::GatherDebugData(FNodeDebugData& DebugData)
+{
+    FString DebugLine = DebugData.GetNodeName(this);
+    DebugLine += FString::Printf(TEXT("(Bindings: %d)"), Bindings.Num());
+    DebugData.AddDebugItem(DebugLine);
+    Source.GatherDebugData(DebugData);
+}
@@ -0,0 +1,114 @@
+#include "MidiClock.h"
+
+namespace
+{
+    constexpr double ClocksPerBeat = 24.0;
+    constexpr int32  TicksToLock = 24;      // one beat within tolerance
+    constexpr double LostAfterPeriods = 8.0; // a gap this long restarts the loop
+}
+
+bool FMidiClockTracker::HandleMessage(const uint8* Data, int32 Size, double Time, TOptional<EMidiTransport>& OutTransport)
+{
+    switch (Data[0])
+    {
+        case 0xF8:
+            Tick(Time);
+            return true;
+
+        case 0xFA:
+            State.Write([](FSnapshot& S) { S.SongTicks = -1; S.bPlaying = 1; });
+            OutTransport = EMidiTransport::Start;
+            return true;
+
+        case 0xFB:
+            State.Write([](FSnapshot& S) { S.bPlaying = 1; });
+            OutTransport = EMidiTransport::Continue;
+            return true;
+
+        case 0xFC:
+            State.Write([](FSnapshot& S) { S.bPlaying = 0; });
+            OutTransport = EMidiTransport::Stop;
+            return true;
+
+        case 0xF2:  // Song Position Pointer: sixteenths (6 clocks), LSB first
+            if (Size >= 3)
+            {
+                const int64 Sixteenths = int64(Data[1] & 0x7F) | (int64(Data[2] & 0x7F) << 7);
+                State.Write([Sixteenths](FSnapshot& S) { S.SongTicks = Sixteenths * 6 - 1; });
+            }
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+void FMidiClockTracker::Tick(double Time)
+{
+    // (Re)acquire: the first two clocks only give a period
+    if (Period <= 0.0 || Time - Expected > LostAfterPeriods * Period)
+    {
+        if (FirstTime <= 0.0 || Time <= FirstTime || Time - FirstTime > 1.0)
+        {
+            FirstTime = Time;
+            Period = 0.0;
+            GoodTicks = 0;
+            State.Write([](FSnapshot& S) { S.Period = 0.0; S.bLocked = 0; if (S.bPlaying) ++S.SongTicks; });
+            return;
+        }
+
+        Period = Time - FirstTime;
+        Expected = Time + Period;
+        FirstTime = 0.0;
+        const double P = Period;
+        State.Write([P, Time](FSnapshot& S) { S.Period = P; S.TickTime = Time; S.bLocked = 0; if (S.bPlaying) ++S.SongTicks; });
+        return;
+    }
+
+    // Delay-locked loop (2nd order, critically damped): phase and period both follow the error
+    const double Error = Time - Expected;
+    const double Omega = 2.0 * PI * BandwidthHz * Period;
+    const double TickTime = Expected + FMath::Sqrt(2.0) * Omega * Error;
+    Period = FMath::Max(Period + Omega * Omega * Error, 1e-4);
+    Expected = TickTime + Period;
+
+    GoodTicks = FMath::Abs(Error) < 0.1 * Period ? GoodTicks + 1 : 0;
+    const double P = Period;
+    const uint8 bLocked = GoodTicks >= TicksToLock;
+    State.Write([P, TickTime, bLocked](FSnapshot& S)
+    {
+        S.Period = P;
+        S.TickTime = TickTime;
+        S.bLocked = bLocked;
+        if (S.bPlaying)
+            ++S.SongTicks;
+    });
+}
+
+FMidiClockState FMidiClockTracker::GetState(double Now) const
+{
+    const FSnapshot S = State.Read();
+
+    FMidiClockState Out;
+    Out.bPlaying = S.bPlaying != 0;
+    Out.bLocked = S.bLocked != 0;
+    if (S.Period <= 0.0)
+        return Out;
+
+    Out.Bpm = float(60.0 / (S.Period * ClocksPerBeat));
+    if (S.SongTicks >= 0)
+    {
+        // Between clocks the position moves with the filtered period, never past the next clock
+        const double Frac = Out.bPlaying ? FMath::Clamp((Now - S.TickTime) / S.Period, 0.0, 1.0) : 0.0;
+        Out.Beat = (double(S.SongTicks) + Frac) / ClocksPerBeat;
+        Out.BeatPhase = float(Out.Beat - FMath::FloorToDouble(Out.Beat));
+    }
+    return Out;
+}
+
+void FMidiClockTracker::Reset()
+{
+    FirstTime = Expected = Period = 0.0;
+    GoodTicks = 0;
+    State.Write([](FSnapshot& S) { S = FSnapshot(); });
+}
@@ -0,0 +1,41 @@
+#include "MidiControlStore.h"
+
+FMidiControlStore::FMidiControlStore()
+    : Slots(MakeUnique<FMidiControlSlot[]>(int32(EKind::Num) * NumChannels * NumNumbers))
+{
+}
+
+int32 FMidiControlStore::SlotIndex(EKind Kind, int32 Chan, int32 Num)
+{
+    if (Kind >= EKind::Num || Chan < 1 || Chan > NumChannels || Num < 0 || Num >= NumNumbers)
+        return INDEX_NONE;
+    return (int32(Kind) * NumChannels + (Chan - 1)) * NumNumbers + Num;
+}
+
+void FMidiControlStore::Write(EKind Kind, int32 Chan, int32 Num, float Value, double Time)
+{
+    const int32 Index = SlotIndex(Kind, Chan, Num);
+    if (Index == INDEX_NONE)
+        return;
+
+    Slots[Index].Write([Value, Time](FMidiControlSample& S)
+    {
+        S.Value = Value;
+        S.Time = Time;
+    });
+}
+
+const FMidiControlSlot* FMidiControlStore::GetSlot(EKind Kind, int32 Chan, int32 Num) const
+{
+    const int32 Index = SlotIndex(Kind, Chan, Num);
+    return Index != INDEX_NONE ? &Slots[Index] : nullptr;
+}
+
+void FMidiControlStore::Reset()
+{
+    for (int32 i = 0; i < int32(EKind::Num) * NumChannels * NumNumbers; ++i)
+    {
+        if (Slots[i].GetWriterView().Time > 0.0)
+            Slots[i].Write([](FMidiControlSample& S) { S = FMidiControlSample(); });
+    }
+}
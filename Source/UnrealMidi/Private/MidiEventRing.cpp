@@ -0,0 +1,36 @@
+#include "MidiEventRing.h"
+
+void FMidiEventRing::Push(const FMidiTimedEvent& Event)
+{
+    const uint64 N = Count.load(std::memory_order_relaxed);
+    Events[N % Capacity] = Event;
+    Count.store(N + 1, std::memory_order_release);
+}
+
+int32 FMidiEventRing::Read(uint64& Cursor, double Before, FMidiTimedEvent* Out, int32 Max) const
+{
+    // Capacity-1 at most: the slot the writer fills next is never read unless the recount says it moved on
+    const uint64 End = Count.load(std::memory_order_acquire);
+    if (End - Cursor > Capacity - 1)
+        Cursor = End - (Capacity - 1);
+
+    int32 N = 0;
+    for (uint64 i = Cursor; i < End && N < Max; ++i)
+    {
+        Out[N] = Events[i % Capacity];
+        if (Out[N].Time >= Before)
+            break;      // not due yet; stays for the next read
+        ++N;
+    }
+
+    // Drop whatever the writer overwrote while we copied
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64 Now = Count.load(std::memory_order_relaxed);
+    const uint64 FirstValid = Now >= Capacity ? Now - Capacity + 1 : 0;
+    const int32 Lost = FirstValid > Cursor ? int32(FMath::Min<uint64>(FirstValid - Cursor, uint64(N))) : 0;
+    if (Lost > 0)
+        FMemory::Memmove(Out, Out + Lost, sizeof(FMidiTimedEvent) * (N - Lost));
+
+    Cursor = FMath::Max(Cursor + uint64(N), FirstValid);
+    return N - Lost;
+}
@@ -0,0 +1,503 @@
+#include "MidiFile.h"
+#include "Algo/BinarySearch.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UnrealMidiLog.h"
+
+namespace
+{
+    uint16 ReadBE16(const uint8* P) { return (uint16)((P[0] << 8) | P[1]); }
+    uint32 ReadBE32(const uint8* P) { return ((uint32)P[0] << 24) | ((uint32)P[1] << 16) | ((uint32)P[2] << 8) | P[3]; }
+
+    void WriteBE16(TArray<uint8>& Out, uint16 V) { Out.Add(uint8(V >> 8)); Out.Add(uint8(V)); }
+    void WriteBE32(TArray<uint8>& Out, uint32 V) { WriteBE16(Out, uint16(V >> 16)); WriteBE16(Out, uint16(V)); }
+
+    void WriteVlq(TArray<uint8>& Out, uint32 V)
+    {
+        uint8 Bytes[4];
+        int32 N = 0;
+        do { Bytes[N++] = V & 0x7F; V >>= 7; } while (V && N < 4);
+        while (N-- > 0)
+        {
+            Out.Add(Bytes[N] | (N > 0 ? 0x80 : 0x00));
+        }
+    }
+
+    // Data bytes following a channel status byte
+    int32 ChannelDataLength(uint8 Status)
+    {
+        const uint8 Hi = Status & 0xF0;
+        return (Hi == 0xC0 || Hi == 0xD0) ? 1 : 2;
+    }
+}
+
+// ---------------- Reader ----------------
+
+bool FMidiFileReader::Open(const FString& FilePath)
+{
+    Close();
+
+    if (!File.Open(FilePath))
+        return false;
+
+    const uint8* Base = File.GetData();
+    const int64 Size = File.GetSize();
+
+    if (Size < 14 || FMemory::Memcmp(Base, "MThd", 4) != 0 || ReadBE32(Base + 4) < 6)
+    {
+        UE_LOG(LogUnrealMidi, Warning, TEXT("[SMF] %s is not a Standard MIDI File"), *FilePath);
+        Close();
+        return false;
+    }
+
+    Format = ReadBE16(Base + 8);
+    const uint16 RawDivision = ReadBE16(Base + 12);
+    if (Format > 1)
+    {
+        UE_LOG(LogUnrealMidi, Warning, TEXT("[SMF] %s: format %d is not supported (type 0/1 only)"), *FilePath, Format);
+        Close();
+        return false;
+    }
+
+    if (RawDivision & 0x8000)
+    {
+        // SMPTE: -frames per second in the high byte, ticks per frame in the low byte
+        const int32 Fps = -static_cast<int8>(RawDivision >> 8);
+        SmpteTicksPerSecond = (Fps == 29 ? 29.97 : (double)Fps) * (RawDivision & 0xFF);
+        Division = 0;
+    }
+    else
+    {
+        Division = FMath::Max<uint16>(RawDivision, 1);
+    }
+
+    // Chunk directory only; track contents are left untouched until playback needs them
+    for (int64 Pos = 8 + ReadBE32(Base + 4); Pos + 8 <= Size; )
+    {
+        const int64 Len = ReadBE32(Base + Pos + 4);
+        if (FMemory::Memcmp(Base + Pos, "MTrk", 4) == 0)
+        {
+            FTrack& T = Tracks.AddDefaulted_GetRef();
+            T.Begin = Pos + 8;
+            T.End = FMath::Min(T.Begin + Len, Size);
+        }
+        Pos += 8 + Len;
+    }
+
+    if (Tracks.Num() == 0)
+    {
+        UE_LOG(LogUnrealMidi, Warning, TEXT("[SMF] %s has no tracks"), *FilePath);
+        Close();
+        return false;
+    }
+
+    DeviceName = FPaths::GetBaseFilename(FilePath);
+    Cursors.SetNum(Tracks.Num());
+    BuildTempoMap();
+    return Seek(0.0);
+}
+
+void FMidiFileReader::Close()
+{
+    File.Close();
+    Tracks.Reset();
+    Cursors.Reset();
+    TempoMap.Reset();
+    Format = 0;
+    Division = MidiFile::ExportDivision;
+    SmpteTicksPerSecond = 0.0;
+}
+
+bool FMidiFileReader::ReadVlq(int64& Pos, int64 End, uint32& Out) const
+{
+    const uint8* Base = File.GetData();
+    Out = 0;
+    for (int32 i = 0; i < 4 && Pos < End; ++i)
+    {
+        const uint8 B = Base[Pos++];
+        Out = (Out << 7) | (B & 0x7F);
+        if (!(B & 0x80))
+            return true;
+    }
+    return false;
+}
+
+bool FMidiFileReader::ReadDelta(FCursor& C, const FTrack& Track) const
+{
+    uint32 Delta = 0;
+    if (C.Pos >= Track.End || !ReadVlq(C.Pos, Track.End, Delta))
+    {
+        C.bDone = true;
+        return false;
+    }
+    C.Tick += Delta;
+    return true;
+}
+
+bool FMidiFileReader::ReadEvent(FCursor& C, const FTrack& Track, FMidiRecordedMessage* Out, int32& OutMetaType)
+{
+    const uint8* Base = File.GetData();
+    OutMetaType = INDEX_NONE;
+
+    if (C.Pos >= Track.End)
+    {
+        C.bDone = true;
+        return false;
+    }
+
+    const uint8 B = Base[C.Pos];
+
+    // Meta event: FF <type> <len> <data>
+    if (B == 0xFF)
+    {
+        if (C.Pos + 2 > Track.End) { C.bDone = true; return false; }
+        OutMetaType = Base[C.Pos + 1];
+        C.Pos += 2;
+
+        uint32 Len = 0;
+        if (!ReadVlq(C.Pos, Track.End, Len) || C.Pos + Len > Track.End) { C.bDone = true; return false; }
+        if (Out)
+        {
+            Out->Data = Base + C.Pos;
+            Out->Size = (int32)Len;
+        }
+        C.Pos += Len;
+        C.RunningStatus = 0;
+        if (OutMetaType == 0x2F)
+            C.bDone = true; // End of Track
+        return true;
+    }
+
+    // SysEx: F0 <len> <data...F7> or escaped F7 <len> <raw bytes>
+    if (B == 0xF0 || B == 0xF7)
+    {
+        ++C.Pos;
+        uint32 Len = 0;
+        if (!ReadVlq(C.Pos, Track.End, Len) || C.Pos + Len > Track.End) { C.bDone = true; return false; }
+        if (Out)
+        {
+            if (B == 0xF0)
+            {
+                Scratch.Reset();
+                Scratch.Add(0xF0);
+                Scratch.Append(Base + C.Pos, (int32)Len);
+                Out->Data = Scratch.GetData();
+                Out->Size = Scratch.Num();
+            }
+            else
+            {
+                Out->Data = Base + C.Pos;
+                Out->Size = (int32)Len;
+            }
+        }
+        C.Pos += Len;
+        C.RunningStatus = 0;
+        return true;
+    }
+
+    // Channel message, possibly using running status
+    const bool bRunning = (B & 0x80) == 0;
+    const uint8 Status = bRunning ? C.RunningStatus : B;
+    if (Status < 0x80 || Status >= 0xF0)
+    {
+        C.bDone = true; // running status without a prior status byte: corrupt track
+        return false;
+    }
+
+    const int64 StatusPos = C.Pos;
+    if (!bRunning) ++C.Pos;
+
+    const int32 DataLen = ChannelDataLength(Status);
+    if (C.Pos + DataLen > Track.End) { C.bDone = true; return false; }
+
+    if (Out)
+    {
+        if (!bRunning)
+        {
+            Out->Data = Base + StatusPos; // zero-copy
+        }
+        else
+        {
+            Scratch.Reset();
+            Scratch.Add(Status);
+            Scratch.Append(Base + C.Pos, DataLen);
+            Out->Data = Scratch.GetData();
+        }
+        Out->Size = DataLen + 1;
+    }
+
+    C.RunningStatus = Status;
+    C.Pos += DataLen;
+    return true;
+}
+
+void FMidiFileReader::BuildTempoMap()
+{
+    TempoMap.Reset();
+    TempoMap.Add(FTempoPoint());
+    if (SmpteTicksPerSecond > 0.0)
+        return;
+
+    // Type 1 keeps tempo on the conductor track; type 0 has only one track anyway
+    const FTrack& Track = Tracks[0];
+    FCursor C;
+    C.Pos = Track.Begin;
+    C.bDone = false;
+
+    FMidiRecordedMessage Meta;
+    int32 MetaType = INDEX_NONE;
+    while (!C.bDone && ReadDelta(C, Track) && ReadEvent(C, Track, &Meta, MetaType))
+    {
+        if (MetaType != 0x51 || Meta.Size != 3)
+            continue;
+
+        const uint32 Micros = ((uint32)Meta.Data[0] << 16) | ((uint32)Meta.Data[1] << 8) | Meta.Data[2];
+        const FTempoPoint& Prev = TempoMap.Last();
+
+        FTempoPoint P;
+        P.Tick = C.Tick;
+        P.Seconds = Prev.Seconds + (double)(C.Tick - Prev.Tick) * Prev.MicrosPerQuarter / (1e6 * Division);
+        P.MicrosPerQuarter = FMath::Max<uint32>(Micros, 1);
+
+        if (Prev.Tick == P.Tick)
+            TempoMap.Last() = P;
+        else
+            TempoMap.Add(P);
+    }
+}
+
+void FMidiFileReader::IndexTrack(FTrack& Track)
+{
+    Track.SeekPoints.Reset();
+
+    const int64 Interval = SmpteTicksPerSecond > 0.0 ? FMath::Max<int64>((int64)(SmpteTicksPerSecond * 0.5), 1) : Division;
+
+    FCursor C;
+    C.Pos = Track.Begin;
+    C.bDone = false;
+
+    int64 LastPointTick = -Interval;
+    int32 MetaType = INDEX_NONE;
+    while (!C.bDone)
+    {
+        // One seek point per beat, taken between events so it can be resumed with ReadDelta()
+        if (C.Tick - LastPointTick >= Interval)
+        {
+            Track.SeekPoints.Add({ C.Tick, C.Pos, C.RunningStatus });
+            LastPointTick = C.Tick;
+        }
+
+        if (!ReadDelta(C, Track) || !ReadEvent(C, Track, nullptr, MetaType))
+            break;
+        Track.LastTick = C.Tick;
+    }
+
+    Track.bIndexed = true;
+}
+
+double FMidiFileReader::GetDurationSeconds()
+{
+    int64 LastTick = 0;
+    for (FTrack& Track : Tracks)
+    {
+        if (!Track.bIndexed)
+            IndexTrack(Track);
+        LastTick = FMath::Max(LastTick, Track.LastTick);
+    }
+    return TicksToSeconds(LastTick);
+}
+
+double FMidiFileReader::TicksToSeconds(int64 Tick) const
+{
+    if (SmpteTicksPerSecond > 0.0)
+        return Tick / SmpteTicksPerSecond;
+
+    const int32 Index = FMath::Max(Algo::UpperBoundBy(TempoMap, Tick, &FTempoPoint::Tick) - 1, 0);
+    const FTempoPoint& P = TempoMap[Index];
+    return P.Seconds + (double)(Tick - P.Tick) * P.MicrosPerQuarter / (1e6 * Division);
+}
+
+int64 FMidiFileReader::SecondsToTicks(double Seconds) const
+{
+    if (SmpteTicksPerSecond > 0.0)
+        return (int64)FMath::CeilToDouble(Seconds * SmpteTicksPerSecond);
+
+    const int32 Index = FMath::Max(Algo::UpperBoundBy(TempoMap, Seconds, &FTempoPoint::Seconds) - 1, 0);
+    const FTempoPoint& P = TempoMap[Index];
+    return P.Tick + (int64)FMath::CeilToDouble((Seconds - P.Seconds) * 1e6 * Division / P.MicrosPerQuarter);
+}
+
+bool FMidiFileReader::Seek(double Seconds)
+{
+    if (!IsOpen())
+        return false;
+
+    const int64 Target = Seconds > 0.0 ? SecondsToTicks(Seconds) : 0;
+
+    for (int32 i = 0; i < Tracks.Num(); ++i)
+    {
+        FTrack& Track = Tracks[i];
+        FCursor& C = Cursors[i];
+
+        // Rewinding needs no index, so Open() stays cheap; the first seek past the start builds it.
+        // Otherwise resume from the last seek point before the target: a point at the target tick may sit
+        // between events of that tick, and the ones before it must play too. Then skip the remainder.
+        FSeekPoint P{ 0, Track.Begin, 0 };
+        if (Target > 0)
+        {
+            if (!Track.bIndexed)
+                IndexTrack(Track);
+
+            const int32 PointIndex = Algo::LowerBoundBy(Track.SeekPoints, Target, &FSeekPoint::Tick) - 1;
+            if (Track.SeekPoints.IsValidIndex(PointIndex))
+                P = Track.SeekPoints[PointIndex];
+        }
+
+        C.Pos = P.Offset;
+        C.Tick = P.Tick;
+        C.RunningStatus = P.RunningStatus;
+        C.bDone = false;
+
+        int32 MetaType = INDEX_NONE;
+        if (!ReadDelta(C, Track))
+            continue;
+        while (!C.bDone && C.Tick < Target)
+        {
+            if (!ReadEvent(C, Track, nullptr, MetaType) || C.bDone)
+                break;
+            ReadDelta(C, Track);
+        }
+    }
+    return true;
+}
+
+bool FMidiFileReader::Next(FMidiRecordedMessage& Out)
+{
+    while (true)
+    {
+        // Merge tracks by tick; the track count is small so a linear scan beats a heap
+        int32 Best = INDEX_NONE;
+        for (int32 i = 0; i < Cursors.Num(); ++i)
+        {
+            if (!Cursors[i].bDone && (Best == INDEX_NONE || Cursors[i].Tick < Cursors[Best].Tick))
+                Best = i;
+        }
+        if (Best == INDEX_NONE)
+            return false;
+
+        FCursor& C = Cursors[Best];
+        const FTrack& Track = Tracks[Best];
+        const int64 Tick = C.Tick;
+
+        int32 MetaType = INDEX_NONE;
+        if (!ReadEvent(C, Track, &Out, MetaType))
+            continue;
+        if (!C.bDone)
+            ReadDelta(C, Track);
+
+        // Tempo and text meta events are consumed here, not played
+        if (MetaType != INDEX_NONE)
+            continue;
+
+        Out.TimeSeconds = TicksToSeconds(Tick);
+        return true;
+    }
+}
+
+// ---------------- Writer ----------------
+
+bool FMidiFileWriter::ExportRecording(const FString& RecordingPath, const FString& MidiPath)
+{
+    FMidiRecordingReader Reader;
+    if (!Reader.Open(RecordingPath))
+        return false;
+
+    return WriteType0(Reader.GetDeviceName(), Reader, MidiPath);
+}
+
+bool FMidiFileWriter::WriteType0(const FString& TrackName, IMidiReplaySource& Source, const FString& MidiPath)
+{
+    if (!Source.Seek(0.0))
+        return false;
+
+    TArray<uint8> Track;
+    Track.Reserve(64 * 1024);
+
+    // Track name + fixed tempo at tick 0
+    FTCHARToUTF8 Name(*TrackName);
+    WriteVlq(Track, 0);
+    Track.Append({ 0xFF, 0x03 });
+    WriteVlq(Track, (uint32)Name.Length());
+    Track.Append(reinterpret_cast<const uint8*>(Name.Get()), Name.Length());
+
+    WriteVlq(Track, 0);
+    Track.Append({ 0xFF, 0x51, 0x03,
+        uint8(MidiFile::ExportTempo >> 16), uint8(MidiFile::ExportTempo >> 8), uint8(MidiFile::ExportTempo) });
+
+    const double TicksPerSecond = MidiFile::ExportDivision * 1e6 / MidiFile::ExportTempo;
+
+    int64 LastTick = 0;
+    uint8 LastStatus = 0;
+    int32 NumEvents = 0;
+
+    FMidiRecordedMessage Msg;
+    while (Source.Next(Msg))
+    {
+        if (!Msg.Data || Msg.Size <= 0)
+            continue;
+
+        const uint8 Status = Msg.Data[0];
+        const bool bSysEx = Status == 0xF0;
+        const bool bChannel = Status >= 0x80 && Status < 0xF0;
+
+        // Real-time and system common bytes have no place in an SMF track
+        if (!bSysEx && !(bChannel && Msg.Size > ChannelDataLength(Status)))
+            continue;
+
+        const int64 Tick = FMath::Max(LastTick, (int64)FMath::RoundToDouble(Msg.TimeSeconds * TicksPerSecond));
+        WriteVlq(Track, (uint32)(Tick - LastTick));
+        LastTick = Tick;
+
+        if (bSysEx)
+        {
+            Track.Add(0xF0);
+            WriteVlq(Track, (uint32)(Msg.Size - 1));
+            Track.Append(Msg.Data + 1, Msg.Size - 1);
+            LastStatus = 0; // SysEx cancels running status
+        }
+        else
+        {
+            if (Status != LastStatus)
+            {
+                Track.Add(Status);
+                LastStatus = Status;
+            }
+            Track.Append(Msg.Data + 1, ChannelDataLength(Status));
+        }
+        ++NumEvents;
+    }
+
+    WriteVlq(Track, 0);
+    Track.Append({ 0xFF, 0x2F, 0x00 });
+
+    TArray<uint8> Out;
+    Out.Reserve(Track.Num() + 22);
+    Out.Append(reinterpret_cast<const uint8*>("MThd"), 4);
+    WriteBE32(Out, 6);
+    WriteBE16(Out, 0); // format 0
+    WriteBE16(Out, 1); // one track
+    WriteBE16(Out, MidiFile::ExportDivision);
+    Out.Append(reinterpret_cast<const uint8*>("MTrk"), 4);
+    WriteBE32(Out, (uint32)Track.Num());
+    Out.Append(Track);
+
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(MidiPath), true);
+    if (!FFileHelper::SaveArrayToFile(Out, *MidiPath))
+    {
+        UE_LOG(LogUnrealMidi, Warning, TEXT("[SMF] Failed to write %s"), *MidiPath);
+        return false;
+    }
+
+    UE_LOG(LogUnrealMidi, Display, TEXT("[SMF] Exported %d event(s) to %s"), NumEvents, *MidiPath);
+    return true;
+}
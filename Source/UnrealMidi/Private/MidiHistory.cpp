@@ -0,0 +1,196 @@
+#include "MidiHistory.h"
+
+void FMidiValueHistory::Configure(const FMidiHistorySettings& InSettings)
+{
+    Settings = InSettings;
+    const int32 Controls[] = { FMath::Clamp(Settings.CcControls, 0, 4096), FMath::Clamp(Settings.NoteControls, 0, 4096) };
+    const int32 Depths[]   = { FMath::Clamp(Settings.CcDepth, 2, 4096),    FMath::Clamp(Settings.NoteDepth, 2, 4096) };
+
+    NumRings = Controls[0] + Controls[1];
+    Rings = MakeUnique<FRing[]>(FMath::Max(NumRings, 1));
+
+    int32 Ring = 0, Offset = 0;
+    for (int32 k = 0; k < int32(EKind::Num); ++k)
+    {
+        FirstRing[k] = Ring;
+        for (int32 i = 0; i < Controls[k]; ++i, ++Ring)
+        {
+            Rings[Ring].Offset = Offset;
+            Rings[Ring].Depth = Depths[k];
+            Offset += Depths[k];
+        }
+    }
+    FirstRing[int32(EKind::Num)] = Ring;
+
+    Samples.SetNumZeroed(Offset);
+
+    const uint32 TableSize = FMath::RoundUpToPowerOfTwo(uint32(FMath::Max(NumRings, 1) * 2));
+    Keys = MakeUnique<std::atomic<uint32>[]>(TableSize);
+    RingOfKey.SetNumZeroed(TableSize);
+    KeyMask = TableSize - 1;
+
+    Reset();
+}
+
+void FMidiValueHistory::Reset()
+{
+    for (int32 i = 0; i < NumRings; ++i)
+        Rings[i].Count.store(0, std::memory_order_relaxed);
+    for (uint32 i = 0; Keys && i <= KeyMask; ++i)
+        Keys[i].store(0, std::memory_order_relaxed);
+    for (int32 k = 0; k < int32(EKind::Num); ++k)
+        NextRing[k] = FirstRing[k];
+}
+
+uint32 FMidiValueHistory::MakeKey(EKind Kind, int32 Chan, int32 Num)
+{
+    // Never 0 (= empty slot)
+    return ((uint32(Kind) + 1) << 28) | ((uint32(Chan) & 0xFFF) << 16) | (uint32(Num) & 0xFFFF);
+}
+
+int32 FMidiValueHistory::FindRing(uint32 Key) const
+{
+    if (!Keys)
+        return INDEX_NONE;
+
+    for (uint32 i = (Key * 2654435761u) & KeyMask, n = 0; n <= KeyMask; i = (i + 1) & KeyMask, ++n)
+    {
+        const uint32 K = Keys[i].load(std::memory_order_acquire);
+        if (K == Key) return RingOfKey[i];
+        if (K == 0)   return INDEX_NONE;
+    }
+    return INDEX_NONE;
+}
+
+void FMidiValueHistory::Record(EKind Kind, int32 Chan, int32 Num, float Value, double Time)
+{
+    const uint32 Key = MakeKey(Kind, Chan, Num);
+    int32 Ring = FindRing(Key);
+    if (Ring == INDEX_NONE)
+    {
+        const int32 k = int32(Kind);
+        if (NextRing[k] >= FirstRing[k + 1])
+            return;     // over budget
+
+        uint32 i = (Key * 2654435761u) & KeyMask;
+        while (Keys[i].load(std::memory_order_relaxed) != 0)
+            i = (i + 1) & KeyMask;
+        Ring = NextRing[k]++;
+        RingOfKey[i] = Ring;
+        Keys[i].store(Key, std::memory_order_release);
+    }
+
+    FRing& R = Rings[Ring];
+    const uint32 Count = R.Count.load(std::memory_order_relaxed);
+    Samples[R.Offset + int32(Count % uint32(R.Depth))] = { Time, Value };
+    R.Count.store(Count + 1, std::memory_order_release);
+}
+
+bool FMidiValueHistory::Snapshot(EKind Kind, int32 Chan, int32 Num, double Time, FSnapshot& Out) const
+{
+    const int32 Ring = FindRing(MakeKey(Kind, Chan, Num));
+    if (Ring == INDEX_NONE)
+        return false;
+
+    // Depth-1 samples: the slot the writer fills next is never read unless the recount says it moved on
+    const FRing& R = Rings[Ring];
+    const uint32 End = R.Count.load(std::memory_order_acquire);
+    const uint32 N = FMath::Min(End, uint32(R.Depth - 1));
+
+    Out.SetNumUninitialized(N);
+    for (uint32 i = 0; i < N; ++i)
+        Out[i] = Samples[R.Offset + int32((End - N + i) % uint32(R.Depth))];
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint32 Lost = FMath::Min(R.Count.load(std::memory_order_relaxed) - End, N);
+    if (Lost > 0)
+        Out.RemoveAt(0, Lost);
+
+    // Nothing newer than needed: the first sample after Time stays as the one to interpolate towards
+    int32 Last = Out.Num();
+    while (Last > 1 && Out[Last - 2].Time > Time)
+        --Last;
+    Out.SetNum(Last);
+    return Out.Num() > 0;
+}
+
+bool FMidiValueHistory::SampleAt(EKind Kind, int32 Chan, int32 Num, double Time, EMidiHistoryInterp Interp, float& OutValue) const
+{
+    FSnapshot S;
+    if (!Snapshot(Kind, Chan, Num, Time, S))
+        return false;
+
+    const int32 Count = S.Num();
+    if (Count == 1 || Time <= S[0].Time || Time >= S[Count - 1].Time)
+    {
+        OutValue = Time <= S[0].Time ? S[0].Value : S[Count - 1].Value;
+        return true;
+    }
+
+    // Segment i .. i+1 around Time
+    int32 i = Count - 2;
+    while (i > 0 && S[i].Time > Time)
+        --i;
+    const FSample& A = S[i];
+    const FSample& B = S[i + 1];
+    const double H = B.Time - A.Time;
+    const float Alpha = H > 0.0 ? float((Time - A.Time) / H) : 1.f;
+
+    switch (Interp)
+    {
+        case EMidiHistoryInterp::Step:
+            OutValue = A.Value;
+            break;
+
+        case EMidiHistoryInterp::Linear:
+            OutValue = FMath::Lerp(A.Value, B.Value, Alpha);
+            break;
+
+        case EMidiHistoryInterp::Hermite:
+        {
+            // Finite-difference tangents (one-sided at the ends), scaled to the segment
+            auto Slope = [&S](int32 From, int32 To)
+            {
+                const double Dt = S[To].Time - S[From].Time;
+                return Dt > 0.0 ? float((S[To].Value - S[From].Value) / Dt) : 0.f;
+            };
+            const float TA = Slope(FMath::Max(i - 1, 0), i + 1) * float(H);
+            const float TB = Slope(i, FMath::Min(i + 2, Count - 1)) * float(H);
+            OutValue = FMath::Clamp(FMath::CubicInterp(A.Value, TA, B.Value, TB, Alpha), 0.f, 1.f);
+            break;
+        }
+    }
+    return true;
+}
+
+bool FMidiValueHistory::GetDerivatives(EKind Kind, int32 Chan, int32 Num, double Time, float& OutVelocity, float& OutAcceleration) const
+{
+    FSnapshot S;
+    if (!Snapshot(Kind, Chan, Num, Time, S))
+        return false;
+
+    while (S.Num() > 0 && S.Last().Time > Time)
+        S.Pop();
+
+    OutVelocity = 0.f;
+    OutAcceleration = 0.f;
+    const int32 n = S.Num();
+    if (n < 2)
+        return n == 1;
+
+    auto Slope = [&S](int32 From, int32 To)
+    {
+        const double Dt = S[To].Time - S[From].Time;
+        return Dt > 0.0 ? double(S[To].Value - S[From].Value) / Dt : 0.0;
+    };
+
+    const double V1 = Slope(n - 2, n - 1);
+    OutVelocity = float(V1);
+    if (n >= 3)
+    {
+        const double V0 = Slope(n - 3, n - 2);
+        const double Span = 0.5 * (S[n - 1].Time - S[n - 3].Time);
+        OutAcceleration = Span > 0.0 ? float((V1 - V0) / Span) : 0.f;
+    }
+    return true;
+}
@@ -0,0 +1,119 @@
+#include "MidiInputBackend.h"
+#include "HAL/PlatformTime.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "RtMidi.h"
+THIRD_PARTY_INCLUDES_END
+#include "UnrealMidiLog.h"
+
+static RtMidi::Api ToRtMidiApi(EMidiBackendApi Api)
+{
+    switch (Api)
+    {
+        case EMidiBackendApi::WindowsMM: return RtMidi::Api::WINDOWS_MM;
+        case EMidiBackendApi::CoreMidi:  return RtMidi::Api::MACOSX_CORE;
+        case EMidiBackendApi::Alsa:      return RtMidi::Api::LINUX_ALSA;
+        case EMidiBackendApi::Jack:      return RtMidi::Api::UNIX_JACK;
+        default:                         return RtMidi::Api::UNSPECIFIED;
+    }
+}
+
+EMidiBackendApi MidiBackend::ParseApi(const FString& Name)
+{
+    if (Name.Equals(TEXT("WindowsMM"), ESearchCase::IgnoreCase)) return EMidiBackendApi::WindowsMM;
+    if (Name.Equals(TEXT("CoreMidi"), ESearchCase::IgnoreCase))  return EMidiBackendApi::CoreMidi;
+    if (Name.Equals(TEXT("Alsa"), ESearchCase::IgnoreCase))      return EMidiBackendApi::Alsa;
+    if (Name.Equals(TEXT("Jack"), ESearchCase::IgnoreCase))      return EMidiBackendApi::Jack;
+    return EMidiBackendApi::Default;
+}
+
+FRtMidiInputBackend::FRtMidiInputBackend(int32 InPortIndex, EMidiBackendApi InApi)
+    : PortIndex(InPortIndex), Api(InApi)
+{}
+
+TUniquePtr<FRtMidiInputBackend> FRtMidiInputBackend::MakeVirtual(EMidiBackendApi InApi)
+{
+    return MakeUnique<FRtMidiInputBackend>(INDEX_NONE, InApi);
+}
+
+bool FRtMidiInputBackend::GetPortNames(EMidiBackendApi InApi, TArray<FString>& OutNames)
+{
+    OutNames.Reset();
+    try
+    {
+        RtMidiIn In(ToRtMidiApi(InApi));
+        const unsigned int N = In.getPortCount();
+        for (unsigned int i = 0; i < N; ++i)
+            OutNames.Add(UTF8_TO_TCHAR(In.getPortName(i).c_str()));
+        return true;
+    }
+    catch (RtMidiError& e)
+    {
+        UE_LOG(LogUnrealMidi, Error, TEXT("[UnrealMidi] Enumerate MIDI In failed: %s"), UTF8_TO_TCHAR(e.getMessage().c_str()));
+        return false;
+    }
+}
+
+FRtMidiInputBackend::~FRtMidiInputBackend()
+{
+    Close();
+}
+
+bool FRtMidiInputBackend::Open(const FString& ClientName, FMessageSink InSink)
+{
+    Close();
+
+    Sink = MoveTemp(InSink);
+    DriverClock = 0.0;
+
+    try
+    {
+        // Default: whatever API this platform was compiled with (WinMM, CoreMIDI, ALSA)
+        auto* In = new RtMidiIn(ToRtMidiApi(Api));
+        In->ignoreTypes(false, bIgnoreTiming, false);
+
+        const std::string PortName = TCHAR_TO_UTF8(*FString::Printf(TEXT("UnrealMidi_%s"), *ClientName));
+        if (PortIndex == INDEX_NONE)
+            In->openVirtualPort(PortName);
+        else
+            In->openPort(PortIndex, PortName);
+
+        // Keep 'this' + no extra heap allocs
+        In->setCallback([](double DeltaTime, std::vector<unsigned char>* Msg, void* UserData)
+        {
+            auto* Self = static_cast<FRtMidiInputBackend*>(UserData);
+            if (!Self || !Msg || Msg->empty()) return;
+
+            const double Now = FPlatformTime::Seconds();
+
+            // RtMidi only gives deltas: re-anchor on the first message, after long gaps and whenever the
+            // clocks drift apart, so Driver->Callback is the drift since the last anchor, not driver latency
+            Self->DriverClock += DeltaTime;
+            if (Self->DriverClock <= 0.0 || Self->DriverClock > Now || Now - Self->DriverClock > 0.25)
+                Self->DriverClock = Now;
+
+            Self->Sink(Now, Msg->data(), (int32)Msg->size(), Self->DriverClock);
+        }, this);
+
+        RtMidiInPtr = In;
+        return true;
+    }
+    catch (RtMidiError& e)
+    {
+        UE_LOG(LogUnrealMidi, Warning, TEXT("RtMidi open failed for '%s': %s"), *ClientName, UTF8_TO_TCHAR(e.getMessage().c_str()));
+        RtMidiInPtr = nullptr;
+        return false;
+    }
+}
+
+void FRtMidiInputBackend::Close()
+{
+    if (RtMidiInPtr)
+    {
+        auto* In = reinterpret_cast<RtMidiIn*>(RtMidiInPtr);
+        In->cancelCallback();
+        try { In->closePort(); } catch(...) {}
+        delete In;
+        RtMidiInPtr = nullptr;
+    }
+}
@@ -1,14 +1,17 @@
 #include "MidiInputDevice.h"
+#include "MidiRecording.h"
+#include "MidiUmp.h"
 #include "HAL/PlatformTime.h"
-
-THIRD_PARTY_INCLUDES_START
-#include "RtMidi.h"
-THIRD_PARTY_INCLUDES_END
+#include "HAL/PlatformProcess.h"
 
 FMidiInputDevice::FMidiInputDevice(const FString& InDeviceName, int32 InPortIndex)
     : DeviceName(InDeviceName), PortIndex(InPortIndex)
 {}
 
+FMidiInputDevice::FMidiInputDevice(const FString& InDeviceName, TUniquePtr<IMidiInputBackend> InBackend)
+    : DeviceName(InDeviceName), Backend(MoveTemp(InBackend))
+{}
+
 FMidiInputDevice::~FMidiInputDevice()
 {
     Close();
@@ -18,83 +21,186 @@ bool FMidiInputDevice::Open()
 {
     Close();
 
-    try
+    if (!Backend)
+        Backend = MakeUnique<FRtMidiInputBackend>(PortIndex);
+
+    Backend->SetUmpSink([this](double Now, const uint32* Words, int32 NumWords, double DriverSeconds)
+    {
+        HandleUmp(Now, Words, NumWords, DriverSeconds);
+    });
+    return Backend->Open(DeviceName, [this](double Now, const uint8* Data, int32 Size, double DriverSeconds)
+    {
+        HandleMessage(Now, Data, Size, DriverSeconds);
+    });
+}
+
+void FMidiInputDevice::Close()
+{
+    if (Backend)
+        Backend->Close();
+}
+
+void FMidiInputDevice::SetRecorder(TSharedPtr<FMidiRecordingWriter, ESPMode::ThreadSafe> InRecorder)
+{
+    FScopeLock _(&RecorderMutex);
+    Recorder = MoveTemp(InRecorder);
+}
+
+void FMidiInputDevice::BeginMessage(double DriverSeconds)
+{
+    // Stage stamps are always wall clock, even when Now is a replayed timeline
+    CurrentStages = FMidiStageTimes();
+    CurrentStages.Callback = FPlatformTime::Seconds();
+    CurrentStages.Driver = DriverSeconds > 0.0 ? DriverSeconds : CurrentStages.Callback;
+
+    if (Counters)
+        FMidiDeviceCounters::Bump(Counters->Received);
+}
+
+void FMidiInputDevice::HandleMessage(double Now, const uint8* Data, int32 Size, double DriverSeconds)
+{
+    if (!Data || Size <= 0) return;
+
+    BeginMessage(DriverSeconds);
+
+    {
+        FScopeLock _(&RecorderMutex);
+        if (Recorder.IsValid())
+            Recorder->Append(Now, Data, Size);
+    }
+
+    // System real-time and song position: tempo/transport only, decoded right here
+    if (Data[0] >= 0xF8 || Data[0] == 0xF2)
     {
-        auto* In = new RtMidiIn(RtMidi::Api::WINDOWS_MM);
-        In->ignoreTypes(false, false, false);
-        In->openPort(PortIndex, TCHAR_TO_UTF8(*FString::Printf(TEXT("UnrealMidi_%s"), *DeviceName)));
+        TOptional<EMidiTransport> Transport;
+        if (Clock && Clock->HandleMessage(Data, Size, CurrentStages.Driver, Transport) && Transport.IsSet())
+            OnTransportDelegate.Broadcast(DeviceName, Transport.GetValue());
+        return;
+    }
 
-        // Keep 'this' + no extra heap allocs
-        In->setCallback([](double, std::vector<unsigned char>* Msg, void* UserData)
+    if (Mpe && Mpe->HandleMessage(Data, Size, Notes))
+    {
+        // Member-channel notes still arrive as NOTE values, so mappings on them keep firing; MPE only adds
+        // the per-note expression. Bend / pressure / CC74 live in the voice table alone.
+        const uint8 MpeStatus = Data[0] & 0xF0;
+        if ((MpeStatus == 0x90 || MpeStatus == 0x80) && Size >= 3)
         {
-            auto* Self = static_cast<FMidiInputDevice*>(UserData);
-            if (!Self || !Msg || Msg->empty()) return;
-
-            const uint8 s = (*Msg)[0];
-            const int Chan = (s & 0x0F) + 1;
-            const uint8 status = s & 0xF0;
-
-            // SysEx is variable length and therefore handled outside of the switch-case
-            if (s == 0xF0)
-            {
-                // Convert std::vector -> TArray for our header signature
-                TArray<uint8> Raw;
-                Raw.Reserve((int32)Msg->size());
-                for (unsigned char b : *Msg)
-                {
-                    Raw.Add((uint8)b);
-                }
-
-                Self->HandleSysEx(Raw);
-                return;
-            }
-
-            const double Now = Self->NowSeconds();
-
-            switch (status)
-            {
-                case 0xB0: // CC
-                    if (Msg->size() >= 3)
-                        Self->HandleCc(Chan, (int)(*Msg)[1], (int)(*Msg)[2]);
-                    break;
-                case 0x90: // Note On (velocity>0) / Off if 0
-                    if (Msg->size() >= 3)
-                        Self->HandleNote(Chan, (int)(*Msg)[1], (int)(*Msg)[2] > 0);
-                    break;
-                case 0x80: // Note Off
-                    if (Msg->size() >= 2)
-                        Self->HandleNote(Chan, (int)(*Msg)[1], false);
-                    break;
-                case 0xC0: // PC (status Cn, data1 = program)
-                    if (Msg->size() >= 2)
-                        Self->HandleProgramChange(Chan, (int)(*Msg)[1]);  // program 0..127
-                    break;
-                default:
-                    break;
-            }
-        }, this);
-
-        RtMidiInPtr = In;
-        return true;
+            HandleNote(Now, (Data[0] & 0x0F) + 1, (int)Data[1], MpeStatus == 0x90 && Data[2] > 0, Data[2], 7);
+            return;
+        }
+        if (Counters) FMidiDeviceCounters::Bump(Counters->Decoded);
+        return;
+    }
+
+    const uint8 s = Data[0];
+    const int Chan = (s & 0x0F) + 1;
+    const uint8 status = s & 0xF0;
+
+    // SysEx is variable length and therefore handled outside of the switch-case
+    if (s == 0xF0)
+    {
+        TArray<uint8> Raw(Data, Size);
+        HandleSysEx(Raw);
+        return;
+    }
+
+    switch (status)
+    {
+        case 0xB0: // CC
+            if (Size >= 3)
+                HandleCc(Now, Chan, (int)Data[1], Data[2], 7);
+            break;
+        case 0x90: // Note On (velocity>0) / Off if 0
+            if (Size >= 3)
+                HandleNote(Now, Chan, (int)Data[1], (int)Data[2] > 0, Data[2], 7);
+            break;
+        case 0x80: // Note Off
+            if (Size >= 2)
+                HandleNote(Now, Chan, (int)Data[1], false, Size >= 3 ? Data[2] : 0, 7);
+            break;
+        case 0xC0: // PC (status Cn, data1 = program)
+            if (Size >= 2)
+                HandleProgramChange(Now, Chan, (int)Data[1]);  // program 0..127
+            break;
+        default:
+            break;
     }
-    catch (RtMidiError& e)
+}
+
+void FMidiInputDevice::HandleUmp(double Now, const uint32* Words, int32 NumWords, double DriverSeconds)
+{
+    for (int32 i = 0; Words && i < NumWords; )
     {
-        UE_LOG(LogTemp, Warning, TEXT("RtMidi open failed for '%s': %s"), *DeviceName, UTF8_TO_TCHAR(e.getMessage().c_str()));
-        RtMidiInPtr = nullptr;
-        return false;
+        const int32 Len = MidiUmp::GetWordCount(Words[i]);
+        if (i + Len > NumWords)
+            break;  // truncated packet
+        HandleUmpPacket(Now, Words + i, Len, DriverSeconds);
+        i += Len;
     }
 }
 
-void FMidiInputDevice::Close()
+void FMidiInputDevice::HandleUmpPacket(double Now, const uint32* Words, int32 NumWords, double DriverSeconds)
 {
-    if (RtMidiInPtr)
+    const uint32 W0 = Words[0];
+    const MidiUmp::EMessageType Type = MidiUmp::GetType(W0);
+
+    if (Type == MidiUmp::EMessageType::Data64)
+    {
+        // SysEx7: up to 6 bytes per packet; status 0 complete, 1 start, 2 continue, 3 end
+        const uint8 Status = uint8((W0 >> 20) & 0x0F);
+        const int32 Count = FMath::Min(int32((W0 >> 16) & 0x0F), 6);
+        if (Status == 0 || Status == 1)
+        {
+            UmpSysEx.Reset();
+            UmpSysEx.Add(0xF0);
+        }
+        const uint8 Bytes[6] = { MidiUmp::GetByte2(W0), MidiUmp::GetByte3(W0),
+                                 uint8(Words[1] >> 24), uint8(Words[1] >> 16), uint8(Words[1] >> 8), uint8(Words[1]) };
+        if (UmpSysEx.Num() > 0)
+            UmpSysEx.Append(Bytes, Count);
+        if ((Status == 0 || Status == 3) && UmpSysEx.Num() > 0)
+        {
+            UmpSysEx.Add(0xF7);
+            HandleMessage(Now, UmpSysEx.GetData(), UmpSysEx.Num(), DriverSeconds);
+            UmpSysEx.Reset();
+        }
+        return;
+    }
+
+    const uint8 Status = MidiUmp::GetStatus(W0);
+    const bool bNative = Type == MidiUmp::EMessageType::Midi2Voice
+        && (Status == 0x80 || Status == 0x90 || Status == 0xB0)
+        && !(Mpe && Mpe->IsEnabled());      // MPE reads the MIDI 1.0 form
+
+    if (!bNative)
+    {
+        // Everything else only on group 0, where MIDI 1.0 channels mean the same thing
+        uint8 Bytes[3];
+        const int32 Size = MidiUmp::GetGroup(W0) == 0 ? MidiUmp::ToMidi1(Words, NumWords, Bytes) : 0;
+        if (Size > 0)
+            HandleMessage(Now, Bytes, Size, DriverSeconds);
+        return;
+    }
+
+    BeginMessage(DriverSeconds);
+
     {
-        auto* In = reinterpret_cast<RtMidiIn*>(RtMidiInPtr);
-        In->cancelCallback();
-        try { In->closePort(); } catch(...) {}
-        delete In;
-        RtMidiInPtr = nullptr;
+        // Recordings stay MIDI 1.0
+        FScopeLock _(&RecorderMutex);
+        uint8 Bytes[3];
+        const int32 Size = Recorder.IsValid() ? MidiUmp::ToMidi1(Words, NumWords, Bytes) : 0;
+        if (Size > 0)
+            Recorder->Append(Now, Bytes, Size);
     }
+
+    const int32 Chan = MidiUmp::GetGroup(W0) * 16 + MidiUmp::GetChannel(W0) + 1;
+    const int32 Index = MidiUmp::GetByte2(W0) & 0x7F;
+    const uint32 W1 = Words[1];
+
+    if (Status == 0xB0)
+        HandleCc(Now, Chan, Index, W1, 32);
+    else
+        HandleNote(Now, Chan, Index, Status == 0x90, W1 >> 16, 16);    // MIDI 2.0: velocity 0 is still a note-on
 }
 
 double FMidiInputDevice::NowSeconds() const
@@ -102,10 +208,22 @@ double FMidiInputDevice::NowSeconds() const
     return FPlatformTime::Seconds();
 }
 
-void FMidiInputDevice::HandleCc(int32 Chan, int32 Cc, int32 Val0to127)
+void FMidiInputDevice::WaitUntil(double WallTime, const std::atomic<bool>& bAbort)
+{
+    // Coarse sleep, then spin the last millisecond for sub-ms accuracy
+    for (double Remaining = WallTime - FPlatformTime::Seconds(); Remaining > 0.0 && !bAbort;
+         Remaining = WallTime - FPlatformTime::Seconds())
+    {
+        if (Remaining > 0.002)
+            FPlatformProcess::SleepNoStats(static_cast<float>(Remaining - 0.001));
+        else
+            FPlatformProcess::YieldThread();
+    }
+}
+
+void FMidiInputDevice::HandleCc(double Now, int32 Chan, int32 Cc, uint32 Raw, uint8 RawBits)
 {
-    const float Now = FPlatformTime::Seconds();
-    const float Norm = FMath::Clamp(Val0to127 / 127.f, 0.f, 1.f);
+    const float Norm = FMath::Clamp(float(double(Raw) / double((uint64(1) << RawBits) - 1)), 0.f, 1.f);
     const FString Id = MakeMidiId(DeviceName, TEXT("CC"), Chan, Cc);
 
     FMidiControlValue V;
@@ -113,18 +231,28 @@ void FMidiInputDevice::HandleCc(int32 Chan, int32 Cc, int32 Val0to127)
     V.Label = MakeMidiLabel(TEXT("CC"), Chan, Cc);
     V.Value = Norm;
     V.TimeSeconds = Now;
-    V.TimeSeconds = Now;
     V.Type = EMidiMessageType::CC;
     V.Device = DeviceName;
     V.ControlId = Cc;
+    V.Channel = Chan;
+    V.RawValue = Raw;
+    V.RawBits = RawBits;
+    V.Stages = CurrentStages;
+
+    // All sound off / all notes off
+    if (Notes && Chan <= 16 && (Cc == 120 || Cc == 123))
+        Notes->AllNotesOff(Chan);
+
+    if (History)
+        History->Record(FMidiValueHistory::EKind::Cc, Chan, Cc, Norm, CurrentStages.Driver > 0.0 ? CurrentStages.Driver : FPlatformTime::Seconds());
 
     { FScopeLock _(&ValuesMutex); LatestById.FindOrAdd(Id) = V; }
+    if (Counters) FMidiDeviceCounters::Bump(Counters->Decoded);
     OnValueDelegate.Broadcast(V);
 }
 
-void FMidiInputDevice::HandleNote(int32 Chan, int32 Note, bool bOn)
+void FMidiInputDevice::HandleNote(double Now, int32 Chan, int32 Note, bool bOn, uint32 Velocity, uint8 RawBits)
 {
-    const float Now = FPlatformTime::Seconds();
     const FString Id = MakeMidiId(DeviceName, TEXT("NOTE"), Chan, Note);
 
     FMidiControlValue V;
@@ -133,28 +261,48 @@ void FMidiInputDevice::HandleNote(int32 Chan, int32 Note, bool bOn)
     V.Value = bOn ? 1.f : 0.f;
     V.TimeSeconds = Now;
     V.Type = EMidiMessageType::CC;
+    V.bNote = true;
     V.Device = DeviceName;
     V.ControlId = Note;
+    V.Channel = Chan;
+    V.RawValue = Velocity;
+    V.RawBits = RawBits;
+    V.Stages = CurrentStages;
+
+    if (Notes && Chan <= 16)   // held notes cover UMP group 0 only
+    {
+        if (bOn) Notes->NoteOn(Chan, Note);
+        else     Notes->NoteOff(Chan, Note);
+    }
+
+    if (History)
+        History->Record(FMidiValueHistory::EKind::Note, Chan, Note, V.Value, CurrentStages.Driver > 0.0 ? CurrentStages.Driver : FPlatformTime::Seconds());
 
     { FScopeLock _(&ValuesMutex); LatestById.FindOrAdd(Id) = V; }
+    if (Counters) FMidiDeviceCounters::Bump(Counters->Decoded);
     OnValueDelegate.Broadcast(V);
 }
 
-void FMidiInputDevice::HandleProgramChange(int Chan, int Program)
+void FMidiInputDevice::HandleProgramChange(double Now, int Chan, int Program)
 {
     FMidiControlValue V;
     V.Id = FString::Printf(TEXT("IN:%s:PC:%d:%d"), *DeviceName, Chan, Program);
     V.Label = FString::Printf(TEXT("Program ch%d #%d"), Chan, Program);
     V.Value = FMath::Clamp(static_cast<float>(Program) / 127.f, 0.f, 1.f); // normalized 0..1
-    V.TimeSeconds = NowSeconds();
+    V.TimeSeconds = Now;
     V.Type = EMidiMessageType::PC;
     V.Device = DeviceName;
     V.ControlId = Program;
+    V.Channel = Chan;
+    V.RawValue = Program;
+    V.Stages = CurrentStages;
 
+    if (Counters) FMidiDeviceCounters::Bump(Counters->Decoded);
     OnValueDelegate.Broadcast(V);
 }
 
 void FMidiInputDevice::HandleSysEx(const TArray<uint8>& Raw)
 {
+    if (Counters) FMidiDeviceCounters::Bump(Counters->Decoded);
     OnSysExDelegate.Broadcast(DeviceName, Raw);
 }
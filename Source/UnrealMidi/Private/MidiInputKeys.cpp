@@ -0,0 +1,190 @@
+#include "MidiInputKeys.h"
+#include "GenericPlatform/GenericApplicationMessageHandler.h"
+#include "GenericPlatform/GenericPlatformInputDeviceMapper.h"
+#include "ToucanMidiConfig.h"
+#include "Misc/ConfigCacheIni.h"
+
+#define LOCTEXT_NAMESPACE "MidiInputKeys"
+
+const FName FMidiInputKeys::MenuCategory(TEXT("MIDI"));
+
+FMidiInputKeys& FMidiInputKeys::Get()
+{
+    static FMidiInputKeys Instance;
+    return Instance;
+}
+
+namespace
+{
+    // IN:<Device>:<TYPE>:<Chan>:<Num>; the device name may itself contain ':'
+    bool SplitControlId(const FString& Id, FString& OutDevice, FString& OutType, FString& OutChan, FString& OutNum)
+    {
+        TArray<FString> Parts;
+        Id.ParseIntoArray(Parts, TEXT(":"), false);
+        if (Parts.Num() < 5 || Parts[0] != TEXT("IN"))
+            return false;
+
+        const int32 N = Parts.Num();
+        OutType = Parts[N - 3];
+        OutChan = Parts[N - 2];
+        OutNum = Parts[N - 1];
+        OutDevice = FString::Join(TArrayView<const FString>(Parts).Slice(1, N - 4), TEXT(":"));
+        return OutType == TEXT("CC") || OutType == TEXT("NOTE");
+    }
+}
+
+FName FMidiInputKeys::MakeKeyName(const FString& Id)
+{
+    FString Device, Type, Chan, Num;
+    if (!SplitControlId(Id, Device, Type, Chan, Num))
+        return NAME_None;
+
+    FString Name = FString::Printf(TEXT("MIDI_%s_%s_%s_%s"), *Device, *Type, *Chan, *Num);
+    for (TCHAR& C : Name)
+    {
+        if (!FChar::IsAlnum(C))
+            C = TEXT('_');
+    }
+    return FName(*Name);
+}
+
+int32 FMidiInputKeys::FindOrAddControl(const FString& Id, bool bSave)
+{
+    if (const int32* Index = ControlIndex.Find(Id))
+        return *Index;
+
+    FString Device, Type, Chan, Num;
+    if (!SplitControlId(Id, Device, Type, Chan, Num))
+        return INDEX_NONE;
+
+    static bool bCategoryAdded = false;
+    if (!bCategoryAdded)
+    {
+        EKeys::AddMenuCategoryDisplayInfo(MenuCategory, LOCTEXT("MidiCategory", "MIDI"), TEXT("GraphEditor.PadEvent_16x"));
+        bCategoryAdded = true;
+    }
+
+    FControl& C = Controls.AddDefaulted_GetRef();
+    C.Key = FKey(MakeKeyName(Id));
+    C.bButton = Type == TEXT("NOTE");
+
+    if (!EKeys::GetKeyDetails(C.Key).IsValid())
+    {
+        const FText Display = FText::Format(LOCTEXT("MidiKey", "MIDI {0} {1} ch{2} #{3}"),
+            FText::FromString(Device), FText::FromString(C.bButton ? TEXT("Note") : TEXT("CC")),
+            FText::FromString(Chan), FText::FromString(Num));
+        EKeys::AddKey(FKeyDetails(C.Key, Display, C.bButton ? 0 : FKeyDetails::Axis1D, MenuCategory));
+    }
+
+    const int32 Index = Controls.Num() - 1;
+    ControlIndex.Add(Id, Index);
+
+    if (bSave)
+    {
+#if WITH_EDITOR
+        const FString& Ini = GEditorPerProjectIni;
+#else
+        const FString& Ini = GGameIni;
+#endif
+        TArray<FString> Saved;
+        GConfig->GetArray(ToucanCfg::Section, ToucanCfg::InputKeysKey, Saved, Ini);
+        Saved.AddUnique(Id);
+        GConfig->SetArray(ToucanCfg::Section, ToucanCfg::InputKeysKey, Saved, Ini);
+        GConfig->Flush(false, Ini);
+    }
+    return Index;
+}
+
+FKey FMidiInputKeys::RegisterControl(const FString& Id)
+{
+    const int32 Index = FindOrAddControl(Id, true);
+    return Index != INDEX_NONE ? Controls[Index].Key : EKeys::Invalid;
+}
+
+void FMidiInputKeys::RegisterSavedControls()
+{
+#if WITH_EDITOR
+    const FString& Ini = GEditorPerProjectIni;
+#else
+    const FString& Ini = GGameIni;
+#endif
+    GConfig->GetBool(ToucanCfg::Section, ToucanCfg::InputKeysEnabledKey, bEnabled, Ini);
+
+    TArray<FString> Saved;
+    GConfig->GetArray(ToucanCfg::Section, ToucanCfg::InputKeysKey, Saved, Ini);
+    for (const FString& Id : Saved)
+        FindOrAddControl(Id, false);
+}
+
+void FMidiInputKeys::SetEnabled(bool bInEnabled)
+{
+    bEnabled = bInEnabled;
+    if (!bEnabled)
+    {
+        for (int32 Index : Dirty)
+            Controls[Index].bDirty = false;
+        Dirty.Reset();
+    }
+}
+
+void FMidiInputKeys::Enqueue(const FMidiControlValue& V)
+{
+    if (!bEnabled || V.bRelative || V.Type == EMidiMessageType::PC)
+        return;
+
+    const int32 Index = FindOrAddControl(V.Id, true);
+    if (Index == INDEX_NONE)
+        return;
+
+    FControl& C = Controls[Index];
+    C.Value = V.Value;
+    if (C.bButton && V.Value > 0.f)
+        C.bPressQueued = true;
+    if (!C.bDirty)
+    {
+        C.bDirty = true;
+        Dirty.Add(Index);
+    }
+}
+
+void FMidiInputKeys::Flush(FGenericApplicationMessageHandler& Handler)
+{
+    if (Dirty.Num() == 0)
+        return;
+
+    IPlatformInputDeviceMapper& Mapper = IPlatformInputDeviceMapper::Get();
+    const FPlatformUserId User = Mapper.GetPrimaryPlatformUser();
+    const FInputDeviceId Device = Mapper.GetDefaultInputDevice();
+
+    for (int32 Index : Dirty)
+    {
+        FControl& C = Controls[Index];
+        C.bDirty = false;
+
+        if (!C.bButton)
+        {
+            if (C.Value != C.SentValue)
+            {
+                Handler.OnControllerAnalog(C.Key.GetFName(), User, Device, C.Value);
+                C.SentValue = C.Value;
+            }
+            continue;
+        }
+
+        if (C.bPressQueued && !C.bSentDown)
+        {
+            Handler.OnControllerButtonPressed(C.Key.GetFName(), User, Device, false);
+            C.bSentDown = true;
+        }
+        C.bPressQueued = false;
+
+        if (C.Value <= 0.f && C.bSentDown)
+        {
+            Handler.OnControllerButtonReleased(C.Key.GetFName(), User, Device, false);
+            C.bSentDown = false;
+        }
+    }
+    Dirty.Reset();
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,7 @@
+#include "MidiKeyInputDevice.h"
+#include "MidiInputKeys.h"
+
+void FMidiKeyInputDevice::SendControllerEvents()
+{
+    FMidiInputKeys::Get().Flush(*MessageHandler);
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "IInputDevice.h"
+
+/** Input device the application polls once per frame; sends FMidiInputKeys' batch through the message handler */
+class FMidiKeyInputDevice : public IInputDevice
+{
+public:
+    explicit FMidiKeyInputDevice(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler)
+        : MessageHandler(InMessageHandler)
+    {
+    }
+
+    virtual void Tick(float DeltaTime) override {}
+    virtual void SendControllerEvents() override;
+    virtual void SetMessageHandler(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler) override { MessageHandler = InMessageHandler; }
+    virtual bool Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar) override { return false; }
+    virtual void SetChannelValue(int32 ControllerId, FForceFeedbackChannelType ChannelType, float Value) override {}
+    virtual void SetChannelValues(int32 ControllerId, const FForceFeedbackValues& Values) override {}
+
+private:
+    TSharedRef<FGenericApplicationMessageHandler> MessageHandler;
+};
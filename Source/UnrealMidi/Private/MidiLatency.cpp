@@ -0,0 +1,300 @@
+#include "MidiLatency.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/OutputDevice.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(UnrealMidiChannel);
+
+// One record per dispatched value; Cycle places it on the Insights timeline next to the frame
+UE_TRACE_EVENT_BEGIN(UnrealMidi, Event)
+    UE_TRACE_EVENT_FIELD(uint64, Cycle)
+    UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Id)
+    UE_TRACE_EVENT_FIELD(float, Value)
+    UE_TRACE_EVENT_FIELD(double, Driver)
+    UE_TRACE_EVENT_FIELD(double, Callback)
+    UE_TRACE_EVENT_FIELD(double, Filter)
+    UE_TRACE_EVENT_FIELD(double, Dispatch)
+UE_TRACE_EVENT_END()
+
+CSV_DEFINE_CATEGORY(UnrealMidi, true);
+
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Driver->Dispatch p50 (ms)"),  STAT_MidiDriverToDispatchP50, STATGROUP_UnrealMidi);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Driver->Dispatch p99 (ms)"),  STAT_MidiDriverToDispatchP99, STATGROUP_UnrealMidi);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Driver->Trigger p50 (ms)"),   STAT_MidiDriverToTriggerP50,  STATGROUP_UnrealMidi);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Driver->Trigger p99 (ms)"),   STAT_MidiDriverToTriggerP99,  STATGROUP_UnrealMidi);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Filter->Dispatch p99 (ms)"),  STAT_MidiFilterToDispatchP99, STATGROUP_UnrealMidi);
+
+TRACE_DECLARE_FLOAT_COUNTER(MidiDriverToDispatchP99, TEXT("UnrealMidi/Driver->Dispatch p99 (ms)"));
+TRACE_DECLARE_FLOAT_COUNTER(MidiDriverToTriggerP99, TEXT("UnrealMidi/Driver->Trigger p99 (ms)"));
+
+static const TCHAR* StageName(EMidiLatencyStage Stage)
+{
+    switch (Stage)
+    {
+        case EMidiLatencyStage::DriverToCallback:  return TEXT("Driver jitter");
+        case EMidiLatencyStage::CallbackToFilter:  return TEXT("Callback->Filter");
+        case EMidiLatencyStage::FilterToDispatch:  return TEXT("Filter->Dispatch");
+        case EMidiLatencyStage::DispatchToTrigger: return TEXT("Dispatch->Trigger");
+        case EMidiLatencyStage::DriverToDispatch:  return TEXT("Driver->Dispatch");
+        case EMidiLatencyStage::DriverToTrigger:   return TEXT("Driver->Trigger");
+        default:                                   return TEXT("?");
+    }
+}
+
+// ---------------- Histogram ----------------
+
+int32 FMidiLatencyHistogram::BucketIndex(uint64 Ns)
+{
+    if (Ns < (1ull << SubBucketBits))
+        return (int32)Ns;
+
+    const int32 Msb = (int32)FMath::FloorLog2_64(Ns);
+    const int32 Sub = (int32)(Ns >> (Msb - SubBucketBits)) & ((1 << SubBucketBits) - 1);
+    return FMath::Min(((Msb - SubBucketBits + 1) << SubBucketBits) | Sub, NumBuckets - 1);
+}
+
+double FMidiLatencyHistogram::BucketUpperNs(int32 Index)
+{
+    if (Index < (1 << SubBucketBits))
+        return Index + 1.0;
+
+    const int32 Msb = (Index >> SubBucketBits) + SubBucketBits - 1;
+    const int32 Sub = Index & ((1 << SubBucketBits) - 1);
+    const double Width = FMath::Pow(2.0, Msb - SubBucketBits);
+    return FMath::Pow(2.0, Msb) + (Sub + 1) * Width;
+}
+
+void FMidiLatencyHistogram::Add(double Seconds)
+{
+    const uint64 Ns = Seconds > 0.0 ? (uint64)(Seconds * 1e9) : 0;
+
+    Buckets[BucketIndex(Ns)].fetch_add(1, std::memory_order_relaxed);
+    SumNs.fetch_add(Ns, std::memory_order_relaxed);
+
+    uint64 Prev = MaxNs.load(std::memory_order_relaxed);
+    while (Ns > Prev && !MaxNs.compare_exchange_weak(Prev, Ns, std::memory_order_relaxed)) {}
+}
+
+void FMidiLatencyHistogram::Reset()
+{
+    for (std::atomic<uint64>& B : Buckets)
+        B.store(0, std::memory_order_relaxed);
+    SumNs.store(0, std::memory_order_relaxed);
+    MaxNs.store(0, std::memory_order_relaxed);
+}
+
+void FMidiLatencyHistogram::Snapshot(uint64 (&OutCounts)[NumBuckets]) const
+{
+    for (int32 i = 0; i < NumBuckets; ++i)
+        OutCounts[i] = Buckets[i].load(std::memory_order_relaxed);
+}
+
+FMidiLatencyPercentiles FMidiLatencyHistogram::GetPercentiles() const
+{
+    uint64 Counts[NumBuckets];
+    Snapshot(Counts);
+    return ComputePercentiles(Counts, SumNs.load(std::memory_order_relaxed), MaxNs.load(std::memory_order_relaxed));
+}
+
+FMidiLatencyPercentiles FMidiLatencyHistogram::ComputePercentiles(const uint64 (&Counts)[NumBuckets], uint64 InSumNs, uint64 InMaxNs)
+{
+    FMidiLatencyPercentiles Out;
+
+    uint64 Total = 0;
+    double EstSumNs = 0.0;
+    int32 Highest = -1;
+    for (int32 i = 0; i < NumBuckets; ++i)
+    {
+        if (Counts[i] == 0) continue;
+        Total += Counts[i];
+        EstSumNs += Counts[i] * (i == 0 ? 0.0 : 0.5 * (BucketUpperNs(i - 1) + BucketUpperNs(i)));
+        Highest = i;
+    }
+    if (Total == 0)
+        return Out;
+
+    // Percentiles report the bucket's upper edge (never under-reports)
+    auto At = [&](double P)
+    {
+        const uint64 Rank = FMath::Max<uint64>(1, (uint64)FMath::CeilToDouble(P * Total));
+        uint64 Cum = 0;
+        for (int32 i = 0; i < NumBuckets; ++i)
+        {
+            Cum += Counts[i];
+            if (Cum >= Rank)
+                return BucketUpperNs(i);
+        }
+        return BucketUpperNs(Highest);
+    };
+
+    // Windowed callers have no exact sum/max; fall back to bucket estimates
+    const double SumNs = InSumNs ? (double)InSumNs : EstSumNs;
+    const double MaxNs = InMaxNs ? (double)InMaxNs : BucketUpperNs(Highest);
+
+    Out.Count  = (int64)Total;
+    Out.MeanMs = float(SumNs / Total * 1e-6);
+    Out.P50Ms  = float(At(0.50) * 1e-6);
+    Out.P99Ms  = float(At(0.99) * 1e-6);
+    Out.P999Ms = float(At(0.999) * 1e-6);
+    Out.MaxMs  = float(MaxNs * 1e-6);
+    return Out;
+}
+
+// ---------------- Tracker ----------------
+
+FMidiLatencyTracker& FMidiLatencyTracker::Get()
+{
+    static FMidiLatencyTracker Instance;
+    return Instance;
+}
+
+FMidiDeviceLatency& FMidiLatencyTracker::FindOrAdd(const FString& DeviceName)
+{
+    {
+        FReadScopeLock _(DevicesLock);
+        if (const TUniquePtr<FMidiDeviceLatency>* D = Devices.Find(DeviceName))
+            return **D;
+    }
+
+    FWriteScopeLock _(DevicesLock);
+    TUniquePtr<FMidiDeviceLatency>& D = Devices.FindOrAdd(DeviceName);
+    if (!D.IsValid())
+        D = MakeUnique<FMidiDeviceLatency>();
+    return *D;
+}
+
+void FMidiLatencyTracker::Add(FMidiDeviceLatency& D, EMidiLatencyStage Stage, double From, double To)
+{
+    // Stages a device never stamps (0) are skipped rather than recorded as huge values
+    if (From > 0.0 && To > 0.0)
+        D.Stages[(int32)Stage].Add(To - From);
+}
+
+void FMidiLatencyTracker::RecordDispatch(const FMidiControlValue& V)
+{
+    const FMidiStageTimes& T = V.Stages;
+    FMidiDeviceLatency& D = FindOrAdd(V.Device);
+
+    Add(D, EMidiLatencyStage::DriverToCallback, T.Driver, T.Callback);
+    Add(D, EMidiLatencyStage::CallbackToFilter, T.Callback, T.Filter);
+    Add(D, EMidiLatencyStage::FilterToDispatch, T.Filter, T.Dispatch);
+    Add(D, EMidiLatencyStage::DriverToDispatch, T.Driver, T.Dispatch);
+
+    UE_TRACE_LOG(UnrealMidi, Event, UnrealMidiChannel)
+        << Event.Cycle(FPlatformTime::Cycles64())
+        << Event.Id(*V.Id, V.Id.Len())
+        << Event.Value(V.Value)
+        << Event.Driver(T.Driver)
+        << Event.Callback(T.Callback)
+        << Event.Filter(T.Filter)
+        << Event.Dispatch(T.Dispatch);
+}
+
+void FMidiLatencyTracker::RecordTrigger(const FString& DeviceName, const FMidiStageTimes& T)
+{
+    if (T.Dispatch <= 0.0)
+        return; // not a pipeline event (direct TriggerFunction call)
+
+    FMidiDeviceLatency& D = FindOrAdd(DeviceName);
+    Add(D, EMidiLatencyStage::DispatchToTrigger, T.Dispatch, T.Trigger);
+    Add(D, EMidiLatencyStage::DriverToTrigger, T.Driver, T.Trigger);
+}
+
+bool FMidiLatencyTracker::GetPercentiles(const FString& DeviceName, EMidiLatencyStage Stage, FMidiLatencyPercentiles& Out) const
+{
+    if (Stage >= EMidiLatencyStage::Num)
+        return false;
+
+    FReadScopeLock _(DevicesLock);
+    const TUniquePtr<FMidiDeviceLatency>* D = Devices.Find(DeviceName);
+    if (!D)
+        return false;
+
+    Out = (*D)->Stages[(int32)Stage].GetPercentiles();
+    return true;
+}
+
+void FMidiLatencyTracker::GetDeviceNames(TArray<FString>& OutNames) const
+{
+    FReadScopeLock _(DevicesLock);
+    Devices.GetKeys(OutNames);
+}
+
+void FMidiLatencyTracker::Reset()
+{
+    FWriteScopeLock _(DevicesLock);
+    for (const auto& Kvp : Devices)
+    {
+        for (FMidiLatencyHistogram& H : Kvp.Value->Stages)
+            H.Reset();
+    }
+    FMemory::Memzero(PrevCounts);
+}
+
+void FMidiLatencyTracker::Tick(float)
+{
+    const double Now = FPlatformTime::Seconds();
+    if (Now - WindowStart >= WindowSeconds)
+    {
+        WindowStart = Now;
+
+        FReadScopeLock _(DevicesLock);
+        for (int32 s = 0; s < (int32)EMidiLatencyStage::Num; ++s)
+        {
+            uint64 Total[FMidiLatencyHistogram::NumBuckets] = {};
+            for (const auto& Kvp : Devices)
+            {
+                uint64 Counts[FMidiLatencyHistogram::NumBuckets];
+                Kvp.Value->Stages[s].Snapshot(Counts);
+                for (int32 b = 0; b < FMidiLatencyHistogram::NumBuckets; ++b)
+                    Total[b] += Counts[b];
+            }
+
+            // Delta against the previous snapshot = events of the last window only
+            uint64 Delta[FMidiLatencyHistogram::NumBuckets];
+            for (int32 b = 0; b < FMidiLatencyHistogram::NumBuckets; ++b)
+            {
+                Delta[b] = Total[b] >= PrevCounts[s][b] ? Total[b] - PrevCounts[s][b] : 0;
+                PrevCounts[s][b] = Total[b];
+            }
+            Window[s] = FMidiLatencyHistogram::ComputePercentiles(Delta, 0, 0);
+        }
+
+        TRACE_COUNTER_SET(MidiDriverToDispatchP99, Window[(int32)EMidiLatencyStage::DriverToDispatch].P99Ms);
+        TRACE_COUNTER_SET(MidiDriverToTriggerP99, Window[(int32)EMidiLatencyStage::DriverToTrigger].P99Ms);
+    }
+
+    // Counter stats clear every frame, so republish the current window each tick
+    const FMidiLatencyPercentiles& ToDispatch = Window[(int32)EMidiLatencyStage::DriverToDispatch];
+    const FMidiLatencyPercentiles& ToTrigger  = Window[(int32)EMidiLatencyStage::DriverToTrigger];
+    const FMidiLatencyPercentiles& FilterDisp = Window[(int32)EMidiLatencyStage::FilterToDispatch];
+
+    SET_FLOAT_STAT(STAT_MidiDriverToDispatchP50, ToDispatch.P50Ms);
+    SET_FLOAT_STAT(STAT_MidiDriverToDispatchP99, ToDispatch.P99Ms);
+    SET_FLOAT_STAT(STAT_MidiDriverToTriggerP50, ToTrigger.P50Ms);
+    SET_FLOAT_STAT(STAT_MidiDriverToTriggerP99, ToTrigger.P99Ms);
+    SET_FLOAT_STAT(STAT_MidiFilterToDispatchP99, FilterDisp.P99Ms);
+
+    CSV_CUSTOM_STAT(UnrealMidi, DriverToDispatchP50Ms, ToDispatch.P50Ms, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(UnrealMidi, DriverToDispatchP99Ms, ToDispatch.P99Ms, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(UnrealMidi, DriverToTriggerP99Ms, ToTrigger.P99Ms, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(UnrealMidi, FilterToDispatchP99Ms, FilterDisp.P99Ms, ECsvCustomStatOp::Set);
+}
+
+void FMidiLatencyTracker::DumpToLog(FOutputDevice& Ar) const
+{
+    FReadScopeLock _(DevicesLock);
+    Ar.Logf(TEXT("=== UnrealMidi latency (ms, since start/reset) ==="));
+    for (const auto& Kvp : Devices)
+    {
+        Ar.Logf(TEXT("%s"), *Kvp.Key);
+        for (int32 s = 0; s < (int32)EMidiLatencyStage::Num; ++s)
+        {
+            const FMidiLatencyPercentiles P = Kvp.Value->Stages[s].GetPercentiles();
+            if (P.Count == 0) continue;
+            Ar.Logf(TEXT("  %-18s n=%-8lld mean=%7.3f p50=%7.3f p99=%7.3f p99.9=%7.3f max=%7.3f"),
+                StageName((EMidiLatencyStage)s), P.Count, P.MeanMs, P.P50Ms, P.P99Ms, P.P999Ms, P.MaxMs);
+        }
+    }
+}
@@ -0,0 +1,134 @@
+#include "MidiLoadGenerator.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformTime.h"
+
+FMidiLoadGenerator::FMidiLoadGenerator(const FString& InDeviceName, const FMidiLoadGenSettings& InSettings, int32 InSeed)
+    : FMidiInputDevice(InDeviceName, -1)
+    , Settings(InSettings)
+    , Random(InSeed)
+{
+    Settings.NumControls = FMath::Clamp(Settings.NumControls, 1, 128);
+    Settings.FirstControl = FMath::Clamp(Settings.FirstControl, 0, 128 - Settings.NumControls);
+    Settings.Channel = FMath::Clamp(Settings.Channel, 1, 16);
+    Settings.RateHz = FMath::Max(Settings.RateHz, 0.01f);
+    Settings.PeriodSeconds = FMath::Max(Settings.PeriodSeconds, 0.001f);
+    Settings.BurstSize = FMath::Max(Settings.BurstSize, 1);
+
+    // SysEx dump template: F0 7D (non-commercial id) <control> <payload...> F7
+    SysExBuffer.SetNumZeroed(FMath::Max(Settings.SysExBytes, 4));
+    SysExBuffer[0] = 0xF0;
+    SysExBuffer[1] = 0x7D;
+    for (int32 i = 3; i < SysExBuffer.Num() - 1; ++i)
+        SysExBuffer[i] = uint8(i & 0x7F);
+    SysExBuffer.Last() = 0xF7;
+}
+
+FMidiLoadGenerator::~FMidiLoadGenerator()
+{
+    Close();
+}
+
+bool FMidiLoadGenerator::Open()
+{
+    Close();
+
+    bStopRequested = false;
+    Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("MidiLoadGen_%s"), *DeviceName), 0, TPri_AboveNormal);
+    return Thread != nullptr;
+}
+
+void FMidiLoadGenerator::Close()
+{
+    if (Thread)
+    {
+        Stop();
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+    FMidiInputDevice::Close();
+}
+
+uint32 FMidiLoadGenerator::Run()
+{
+    const double Start = FPlatformTime::Seconds();
+    const double Interval = 1.0 / Settings.RateHz;
+
+    for (int64 Step = 0; !bStopRequested; ++Step)
+    {
+        // Fixed schedule: if the pipeline cannot keep up we simply fall behind,
+        // which shows up as achieved rate < target rate
+        WaitUntil(Start + Step * Interval, bStopRequested);
+
+        const double Now = NowSeconds();
+        for (int32 i = 0; i < Settings.NumControls && !bStopRequested; ++i)
+        {
+            EmitControl(Now, Settings.FirstControl + i, Step);
+        }
+    }
+    return 0;
+}
+
+void FMidiLoadGenerator::EmitControl(double Now, int32 Control, int64 Step)
+{
+    const EMidiLoadWaveform* Override = Settings.PerControlWaveform.Find(Control);
+    const EMidiLoadWaveform Wave = Override ? *Override : Settings.Waveform;
+
+    const uint8 Chan = uint8(Settings.Channel - 1);
+    const double Phase = (Step / (double)Settings.RateHz) / Settings.PeriodSeconds
+                       + (double)(Control - Settings.FirstControl) / Settings.NumControls;
+
+    switch (Wave)
+    {
+        case EMidiLoadWaveform::Sweep:
+        {
+            const uint8 Msg[3] = { uint8(0xB0 | Chan), uint8(Control), uint8(FMath::Frac(Phase) * 127.0) };
+            Emit(Now, Msg, 3);
+            break;
+        }
+        case EMidiLoadWaveform::Sine:
+        {
+            const double S = FMath::Sin(2.0 * UE_DOUBLE_PI * Phase) * 0.5 + 0.5;
+            const uint8 Msg[3] = { uint8(0xB0 | Chan), uint8(Control), uint8(S * 127.0) };
+            Emit(Now, Msg, 3);
+            break;
+        }
+        case EMidiLoadWaveform::Noise:
+        {
+            const uint8 Msg[3] = { uint8(0xB0 | Chan), uint8(Control), uint8(Random.RandRange(0, 127)) };
+            Emit(Now, Msg, 3);
+            break;
+        }
+        case EMidiLoadWaveform::Burst:
+        {
+            const int64 StepsPerPeriod = FMath::Max<int64>(1, (int64)(Settings.PeriodSeconds * Settings.RateHz));
+            if (Step % StepsPerPeriod != 0)
+                break;
+            for (int32 b = 0; b < Settings.BurstSize; ++b)
+            {
+                const uint8 Msg[3] = { uint8(0xB0 | Chan), uint8(Control), uint8(Random.RandRange(0, 127)) };
+                Emit(Now, Msg, 3);
+            }
+            break;
+        }
+        case EMidiLoadWaveform::NoteStorm:
+        {
+            const bool bOn = (Step & 1) == 0;
+            const uint8 Msg[3] = { uint8((bOn ? 0x90 : 0x80) | Chan), uint8(Control), uint8(bOn ? Random.RandRange(1, 127) : 0) };
+            Emit(Now, Msg, 3);
+            break;
+        }
+        case EMidiLoadWaveform::SysExDump:
+        {
+            SysExBuffer[2] = uint8(Control);
+            Emit(Now, SysExBuffer.GetData(), SysExBuffer.Num());
+            break;
+        }
+    }
+}
+
+void FMidiLoadGenerator::Emit(double Now, const uint8* Data, int32 Size)
+{
+    HandleMessage(Now, Data, Size);
+    NumGenerated.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,43 @@
+#include "MidiMappedFile.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "UnrealMidiLog.h"
+
+FMidiMappedFile::~FMidiMappedFile()
+{
+    Close();
+}
+
+bool FMidiMappedFile::Open(const FString& FilePath)
+{
+    Close();
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    FOpenMappedResult Result = PlatformFile.OpenMappedEx(*FilePath);
+    if (Result.HasError())
+    {
+        UE_LOG(LogUnrealMidi, Warning, TEXT("Cannot map %s: %s"), *FilePath, *Result.GetError().GetMessage());
+        return false;
+    }
+
+    Handle = Result.StealValue();
+    Region.Reset(Handle->MapRegion(0, Handle->GetFileSize()));
+    if (!Region.IsValid())
+    {
+        Close();
+        return false;
+    }
+
+    Base = Region->GetMappedPtr();
+    Length = Region->GetMappedSize();
+    return true;
+}
+
+void FMidiMappedFile::Close()
+{
+    // Region must go before the handle it was mapped from
+    Region.Reset();
+    Handle.Reset();
+    Base = nullptr;
+    Length = 0;
+}
@@ -0,0 +1,269 @@
+#include "MidiMpe.h"
+#include "MidiNoteTracker.h"
+
+namespace
+{
+    float Bend14(const uint8* Data, float RangeSemitones)
+    {
+        const int32 Raw = (int32(Data[2]) << 7) | int32(Data[1]);
+        return (Raw - 8192) / 8192.f * RangeSemitones;
+    }
+}
+
+FMidiMpeDecoder::FMidiMpeDecoder()
+{
+    Reset();
+}
+
+void FMidiMpeDecoder::SetZones(int32 LowerMembers, int32 UpperMembers)
+{
+    LowerMembers = FMath::Clamp(LowerMembers, 0, 15);
+    UpperMembers = FMath::Clamp(UpperMembers, 0, 15);
+    if (LowerMembers > 0 && UpperMembers > 0)
+        UpperMembers = FMath::Min(UpperMembers, 14 - LowerMembers);    // both masters need their channel
+
+    uint32 Bits = 0;
+    for (int32 i = 0; i < LowerMembers; ++i)
+        Bits |= 1u << (1 + i);                  // channels 2..
+    for (int32 i = 0; i < UpperMembers; ++i)
+        Bits |= 1u << (16 + 14 - i);            // channels 15..
+    ZoneBits.store(Bits, std::memory_order_relaxed);
+}
+
+void FMidiMpeDecoder::GetZones(int32& OutLowerMembers, int32& OutUpperMembers) const
+{
+    const uint32 Bits = ZoneBits.load(std::memory_order_relaxed);
+    OutLowerMembers = FMath::CountBits(Bits & 0xFFFFu);
+    OutUpperMembers = FMath::CountBits(Bits >> 16);
+}
+
+int32 FMidiMpeDecoder::ZoneOf(int32 Chan) const
+{
+    const uint32 Bits = ZoneBits.load(std::memory_order_relaxed);
+    const uint32 Bit = 1u << (Chan - 1);
+    if (Bits & Bit)         return 0;
+    if ((Bits >> 16) & Bit) return 1;
+    return INDEX_NONE;
+}
+
+void FMidiMpeDecoder::Reset()
+{
+    for (int32 c = 0; c < 16; ++c)
+    {
+        Channels[c] = FChannelState();
+        if (c == 0 || c == 15)
+            Channels[c].BendRange = 2.f;
+    }
+    Voices.Write([](FMidiMpeVoiceTable& T) { T = FMidiMpeVoiceTable(); });
+}
+
+void FMidiMpeDecoder::TrackRpn(int32 Chan, int32 Cc, int32 Val)
+{
+    FChannelState& C = Channels[Chan - 1];
+    if (Cc == 101) { C.RpnMsb = Val; return; }
+    if (Cc == 100) { C.RpnLsb = Val; return; }
+    if (Cc != 6 || C.RpnMsb != 0)
+        return;
+
+    if (C.RpnLsb == 0)
+    {
+        // Pitch bend sensitivity: on a master it applies to the master, on a member to the whole zone
+        const int32 Zone = ZoneOf(Chan);
+        if (Zone == INDEX_NONE)
+        {
+            C.BendRange = float(Val);
+            return;
+        }
+        for (int32 m = 1; m <= 16; ++m)
+        {
+            if (ZoneOf(m) == Zone)
+                Channels[m - 1].BendRange = float(Val);
+        }
+    }
+    else if (C.RpnLsb == 6 && (Chan == 1 || Chan == 16))
+    {
+        // MPE Configuration Message: data = number of member channels in this zone
+        int32 Lower, Upper;
+        GetZones(Lower, Upper);
+        if (Chan == 1)
+        {
+            Lower = Val;
+            if (Lower + Upper > 14) Upper = FMath::Max(0, 14 - Lower);
+        }
+        else
+        {
+            Upper = Val;
+            if (Lower + Upper > 14) Lower = FMath::Max(0, 14 - Upper);
+        }
+        SetZones(Lower, Upper);
+        Reset();
+    }
+}
+
+bool FMidiMpeDecoder::HandleMessage(const uint8* Data, int32 Size, FMidiNoteState* Notes)
+{
+    const uint8 Status = Data[0] & 0xF0;
+    const int32 Chan = (Data[0] & 0x0F) + 1;
+    if (Status < 0x80 || Status == 0xF0)
+        return false;
+
+    // RPNs (bend range, MCM) are watched on every channel so MPE can switch itself on
+    if (Status == 0xB0 && Size >= 3 && (Data[1] == 101 || Data[1] == 100 || Data[1] == 6))
+        TrackRpn(Chan, Data[1], Data[2]);
+
+    const uint32 Bits = ZoneBits.load(std::memory_order_relaxed);
+    if (Bits == 0)
+        return false;
+
+    // Master channel bend moves the whole zone; other master messages are ordinary controls
+    const bool bLowerMaster = Chan == 1 && (Bits & 0xFFFFu);
+    const bool bUpperMaster = Chan == 16 && (Bits >> 16);
+    if (bLowerMaster || bUpperMaster)
+    {
+        if (Status != 0xE0 || Size < 3)
+            return false;
+        const float Bend = Bend14(Data, Channels[Chan - 1].BendRange);
+        Voices.Write([&](FMidiMpeVoiceTable& T) { T.ZoneBend[bLowerMaster ? 0 : 1] = Bend; });
+        return true;
+    }
+
+    if (ZoneOf(Chan) == INDEX_NONE)
+        return false;
+
+    FChannelState& C = Channels[Chan - 1];
+    const FMidiMpeVoiceTable& Current = Voices.GetWriterView();
+
+    switch (Status)
+    {
+        case 0x90:
+        case 0x80:
+        {
+            if (Size < 3) return true;
+            const uint8 Note = Data[1];
+            const bool bOn = Status == 0x90 && Data[2] > 0;
+
+            if (bOn)
+            {
+                // Free lane, else steal the oldest
+                int32 Lane = INDEX_NONE;
+                uint32 OldestAge = MAX_uint32;
+                for (int32 i = 0; i < FMidiMpeVoiceTable::MaxVoices; ++i)
+                {
+                    if (!(Current.ActiveMask & (1u << i))) { Lane = i; break; }
+                    if (Current.Age[i] < OldestAge) { OldestAge = Current.Age[i]; Lane = i; }
+                }
+
+                if (Notes && (Current.ActiveMask & (1u << Lane)))
+                    Notes->NoteOff(Current.Channel[Lane], Current.Note[Lane]);
+
+                const uint32 Age = NextAge++;
+                Voices.Write([&](FMidiMpeVoiceTable& T)
+                {
+                    T.ActiveMask |= 1u << Lane;
+                    T.Note[Lane] = Note;
+                    T.Channel[Lane] = uint8(Chan);
+                    T.Velocity[Lane] = Data[2];
+                    T.Age[Lane] = Age;
+                    T.Bend[Lane] = C.Bend;
+                    T.Pressure[Lane] = C.Pressure;
+                    T.Timbre[Lane] = C.Timbre;
+                });
+                if (Notes) Notes->NoteOn(Chan, Note);
+            }
+            else
+            {
+                Voices.Write([&](FMidiMpeVoiceTable& T)
+                {
+                    for (uint32 M = T.ActiveMask; M; M &= M - 1)
+                    {
+                        const int32 i = int32(FMath::CountTrailingZeros(M));
+                        if (T.Channel[i] == Chan && T.Note[i] == Note)
+                            T.ActiveMask &= ~(1u << i);
+                    }
+                });
+                if (Notes) Notes->NoteOff(Chan, Note);
+            }
+            return true;
+        }
+
+        case 0xE0: // per-note pitch bend
+            if (Size < 3) return true;
+            C.Bend = Bend14(Data, C.BendRange);
+            break;
+
+        case 0xD0: // channel pressure
+            if (Size < 2) return true;
+            C.Pressure = Data[1] / 127.f;
+            break;
+
+        case 0xA0: // poly aftertouch, sent by some controllers instead of channel pressure
+            if (Size < 3) return true;
+            C.Pressure = Data[2] / 127.f;
+            break;
+
+        case 0xB0:
+            if (Size < 3) return true;
+            if (Data[1] == 74)
+            {
+                C.Timbre = Data[2] / 127.f;
+                break;
+            }
+            if (Data[1] == 120 || Data[1] == 123)
+            {
+                Voices.Write([&](FMidiMpeVoiceTable& T)
+                {
+                    for (int32 i = 0; i < FMidiMpeVoiceTable::MaxVoices; ++i)
+                    {
+                        if (T.Channel[i] == Chan)
+                            T.ActiveMask &= ~(1u << i);
+                    }
+                });
+                if (Notes) Notes->AllNotesOff(Chan);
+                return true;
+            }
+            return false;   // other member CCs stay ordinary controls
+
+        default:
+            return false;
+    }
+
+    // Expression: the channel's voices follow it (normally exactly one)
+    Voices.Write([&](FMidiMpeVoiceTable& T)
+    {
+        for (uint32 M = T.ActiveMask; M; M &= M - 1)
+        {
+            const int32 i = int32(FMath::CountTrailingZeros(M));
+            if (T.Channel[i] == Chan)
+            {
+                T.Bend[i] = C.Bend;
+                T.Pressure[i] = C.Pressure;
+                T.Timbre[i] = C.Timbre;
+            }
+        }
+    });
+    return true;
+}
+
+void FMidiMpeDecoder::GetVoices(TArray<FMidiMpeVoice>& OutVoices) const
+{
+    const FMidiMpeVoiceTable T = Voices.Read();
+
+    OutVoices.Reset(FMath::CountBits(T.ActiveMask));
+    for (uint32 M = T.ActiveMask; M; M &= M - 1)
+    {
+        const int32 i = int32(FMath::CountTrailingZeros(M));
+        const int32 Zone = (T.Channel[i] >= 1 && T.Channel[i] <= 16 && ZoneOf(T.Channel[i]) == 1) ? 1 : 0;
+
+        FMidiMpeVoice& V = OutVoices.AddDefaulted_GetRef();
+        V.Note     = T.Note[i];
+        V.Channel  = T.Channel[i];
+        V.Velocity = T.Velocity[i] / 127.f;
+        V.Bend     = T.Bend[i];
+        V.Pitch    = T.Note[i] + T.Bend[i] + T.ZoneBend[Zone];
+        V.Pressure = T.Pressure[i];
+        V.Timbre   = T.Timbre[i];
+    }
+
+    // Lanes are reused in any order; hand them out low to high
+    OutVoices.StableSort([](const FMidiMpeVoice& A, const FMidiMpeVoice& B) { return A.Note < B.Note; });
+}
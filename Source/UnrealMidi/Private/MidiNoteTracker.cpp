@@ -0,0 +1,87 @@
+#include "MidiNoteTracker.h"
+
+uint16 FMidiNoteMask::PitchClasses() const
+{
+    uint16 Pc = 0;
+    for (int32 W = 0; W < 2; ++W)
+    {
+        for (uint64 Bits = W ? Hi : Lo; Bits; Bits &= Bits - 1)
+            Pc |= uint16(1) << ((W * 64 + int32(FMath::CountTrailingZeros64(Bits))) % 12);
+    }
+    return Pc;
+}
+
+FMidiNoteMask FMidiNoteMask::FromIntervals(TConstArrayView<int32> Intervals)
+{
+    FMidiNoteMask M;
+    for (int32 I : Intervals)
+    {
+        if (I >= 0 && I < 64)        M.Lo |= uint64(1) << I;
+        else if (I >= 64 && I < 128) M.Hi |= uint64(1) << (I - 64);
+    }
+    return M;
+}
+
+FMidiNoteMask FMidiNoteState::GetMask(int32 Chan) const
+{
+    FMidiNoteMask M;
+    if (Chan >= 1 && Chan <= 16)
+    {
+        M.Lo = Held[Chan - 1][0].load(std::memory_order_relaxed);
+        M.Hi = Held[Chan - 1][1].load(std::memory_order_relaxed);
+        return M;
+    }
+
+    for (int32 C = 0; C < 16; ++C)
+    {
+        M.Lo |= Held[C][0].load(std::memory_order_relaxed);
+        M.Hi |= Held[C][1].load(std::memory_order_relaxed);
+    }
+    return M;
+}
+
+int32 FMidiNoteState::GetHeldNotes(int32 Chan, TArray<int32>& OutNotes) const
+{
+    const FMidiNoteMask M = GetMask(Chan);
+    OutNotes.Reset(M.Num());
+    for (int32 W = 0; W < 2; ++W)
+    {
+        for (uint64 Bits = W ? M.Hi : M.Lo; Bits; Bits &= Bits - 1)
+            OutNotes.Add(W * 64 + int32(FMath::CountTrailingZeros64(Bits)));
+    }
+    return OutNotes.Num();
+}
+
+int32 FMidiNoteState::MatchChord(int32 Chan, TConstArrayView<int32> Intervals, bool bExact) const
+{
+    const FMidiNoteMask M = GetMask(Chan);
+    if (M.IsEmpty() || Intervals.Num() == 0)
+        return INDEX_NONE;
+
+    uint32 Shape = 0;
+    for (int32 I : Intervals)
+        Shape |= 1u << (((I % 12) + 12) % 12);
+
+    const uint32 Held = M.PitchClasses();
+    const int32 First = M.Lowest() % 12;
+    for (int32 k = 0; k < 12; ++k)
+    {
+        const int32 Root = (First + k) % 12;
+        const uint32 Rot = ((Shape << Root) | (Shape >> (12 - Root))) & 0xFFFu;
+        if (bExact ? Held == Rot : (Held & Rot) == Rot)
+            return Root;
+    }
+    return INDEX_NONE;
+}
+
+bool FMidiNoteState::MatchVoicing(int32 Chan, TConstArrayView<int32> Intervals) const
+{
+    const FMidiNoteMask M = GetMask(Chan);
+    const int32 Lowest = M.Lowest();
+    if (Lowest == INDEX_NONE)
+        return false;
+
+    FMidiNoteMask Shape = FMidiNoteMask::FromIntervals(Intervals);
+    Shape.Lo |= 1;  // the lowest note is always part of the voicing
+    return (Shape << Lowest) == M;
+}
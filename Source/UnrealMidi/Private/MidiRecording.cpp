@@ -0,0 +1,141 @@
+#include "MidiRecording.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UnrealMidiLog.h"
+
+namespace
+{
+    template<typename T>
+    void WritePod(TArray<uint8>& Out, const T& Value)
+    {
+        Out.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+    }
+
+    template<typename T>
+    bool ReadPod(const uint8* Base, int64 Length, int64& Cursor, T& Out)
+    {
+        if (Cursor + (int64)sizeof(T) > Length) return false;
+        FMemory::Memcpy(&Out, Base + Cursor, sizeof(T));
+        Cursor += sizeof(T);
+        return true;
+    }
+}
+
+// ---------------- Writer ----------------
+
+FMidiRecordingWriter::FMidiRecordingWriter(const FString& InDeviceName, const FString& InFilePath)
+    : DeviceName(InDeviceName), FilePath(InFilePath)
+{
+    FTCHARToUTF8 Name(*DeviceName);
+    const uint16 NameLen = (uint16)FMath::Min(Name.Length(), (int32)MAX_uint16);
+
+    Buffer.Reserve(64 * 1024);
+    WritePod(Buffer, MidiRecording::Magic);
+    WritePod(Buffer, MidiRecording::Version);
+    WritePod(Buffer, NameLen);
+    Buffer.Append(reinterpret_cast<const uint8*>(Name.Get()), NameLen);
+}
+
+void FMidiRecordingWriter::Append(double Now, const uint8* Data, int32 Size)
+{
+    if (!Data || Size <= 0 || Size > MAX_uint16) return;
+
+    FScopeLock _(&Mutex);
+    if (StartTime < 0.0) StartTime = Now;
+
+    WritePod(Buffer, Now - StartTime);
+    WritePod(Buffer, static_cast<uint16>(Size));
+    Buffer.Append(Data, Size);
+    ++NumRecords;
+}
+
+bool FMidiRecordingWriter::Finish()
+{
+    FScopeLock _(&Mutex);
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+
+    if (!FFileHelper::SaveArrayToFile(Buffer, *FilePath))
+    {
+        UE_LOG(LogUnrealMidi, Warning, TEXT("[Record] Failed to write %s"), *FilePath);
+        return false;
+    }
+
+    UE_LOG(LogUnrealMidi, Display, TEXT("[Record] %s: %d message(s) -> %s"), *DeviceName, NumRecords, *FilePath);
+    return true;
+}
+
+int32 FMidiRecordingWriter::GetNumRecords() const
+{
+    FScopeLock _(&Mutex);
+    return NumRecords;
+}
+
+// ---------------- Reader ----------------
+
+bool FMidiRecordingReader::Open(const FString& FilePath)
+{
+    Close();
+
+    if (!File.Open(FilePath))
+        return false;
+
+    const uint8* Base = File.GetData();
+    const int64 Length = File.GetSize();
+
+    int64 Pos = 0;
+    uint32 FileMagic = 0;
+    uint16 FileVersion = 0, NameLen = 0;
+    if (!ReadPod(Base, Length, Pos, FileMagic) || FileMagic != MidiRecording::Magic ||
+        !ReadPod(Base, Length, Pos, FileVersion) || FileVersion != MidiRecording::Version ||
+        !ReadPod(Base, Length, Pos, NameLen) || Pos + NameLen > Length)
+    {
+        UE_LOG(LogUnrealMidi, Warning, TEXT("[Replay] %s is not a UnrealMidi recording"), *FilePath);
+        Close();
+        return false;
+    }
+
+    DeviceName = FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Base + Pos), NameLen));
+    FirstRecord = Cursor = Pos + NameLen;
+    return true;
+}
+
+void FMidiRecordingReader::Close()
+{
+    File.Close();
+    FirstRecord = Cursor = 0;
+}
+
+bool FMidiRecordingReader::Seek(double Seconds)
+{
+    Cursor = FirstRecord;
+
+    // Records are variable length, so skip forward reading only the headers
+    const uint8* Base = File.GetData();
+    const int64 Length = File.GetSize();
+    while (true)
+    {
+        int64 Pos = Cursor;
+        double Time = 0.0;
+        uint16 Size = 0;
+        if (!ReadPod(Base, Length, Pos, Time) || !ReadPod(Base, Length, Pos, Size) || Time >= Seconds)
+            break;
+        Cursor = Pos + Size;
+    }
+    return IsOpen();
+}
+
+bool FMidiRecordingReader::Next(FMidiRecordedMessage& Out)
+{
+    const uint8* Base = File.GetData();
+    const int64 Length = File.GetSize();
+
+    int64 Pos = Cursor;
+    uint16 Size = 0;
+    if (!ReadPod(Base, Length, Pos, Out.TimeSeconds) || !ReadPod(Base, Length, Pos, Size) || Pos + Size > Length)
+        return false;
+
+    Out.Data = Base + Pos;
+    Out.Size = Size;
+    Cursor = Pos + Size;
+    return true;
+}
@@ -0,0 +1,106 @@
+#include "MidiReplayDevice.h"
+#include "MidiFile.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+#include "UnrealMidiLog.h"
+
+FMidiReplayDevice::FMidiReplayDevice(const FString& InFilePath, float InSpeed, bool bInLoop,
+                                     double InStartSeconds, const FString& AsDevice)
+    : FMidiInputDevice(FPaths::GetBaseFilename(InFilePath), -1)
+    , FilePath(InFilePath)
+    , DeviceOverride(AsDevice)
+    , Speed(InSpeed)
+    , bLoop(bInLoop)
+    , StartSeconds(FMath::Max(InStartSeconds, 0.0))
+{}
+
+FMidiReplayDevice::~FMidiReplayDevice()
+{
+    Close();
+}
+
+bool FMidiReplayDevice::Load()
+{
+    const FString Ext = FPaths::GetExtension(FilePath);
+    if (Ext.Equals(TEXT("mid"), ESearchCase::IgnoreCase) || Ext.Equals(TEXT("midi"), ESearchCase::IgnoreCase) ||
+        Ext.Equals(TEXT("smf"), ESearchCase::IgnoreCase))
+    {
+        TUniquePtr<FMidiFileReader> Smf = MakeUnique<FMidiFileReader>();
+        if (!Smf->Open(FilePath))
+            return false;
+        Source = MoveTemp(Smf);
+    }
+    else
+    {
+        TUniquePtr<FMidiRecordingReader> Rec = MakeUnique<FMidiRecordingReader>();
+        if (!Rec->Open(FilePath))
+            return false;
+        Source = MoveTemp(Rec);
+    }
+
+    // Replay as the recorded device so per-device filter settings and mappings apply
+    DeviceName = DeviceOverride.IsEmpty() ? Source->GetDeviceName() : DeviceOverride;
+    return true;
+}
+
+bool FMidiReplayDevice::Open()
+{
+    Close();
+
+    if (!Source.IsValid() && !Load())
+        return false;
+
+    bStopRequested = false;
+    bFinished = false;
+    Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("MidiReplay_%s"), *DeviceName), 0, TPri_AboveNormal);
+    return Thread != nullptr;
+}
+
+void FMidiReplayDevice::Close()
+{
+    if (Thread)
+    {
+        Stop();
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+    FMidiInputDevice::Close();
+}
+
+uint32 FMidiReplayDevice::Run()
+{
+    double TimelineEnd = 0.0;
+    do
+    {
+        Source->Seek(StartSeconds);
+
+        // Keep the timeline monotonic across loop passes, even when replaying faster than real time
+        const double WallStart = FPlatformTime::Seconds();
+        const double Base = FMath::Max(WallStart, TimelineEnd);
+        int64 NumEvents = 0;
+
+        FMidiRecordedMessage Msg;
+        while (!bStopRequested && Source->Next(Msg))
+        {
+            const double Offset = Msg.TimeSeconds - StartSeconds;
+            if (Speed > 0.f)
+                WaitUntil(WallStart + Offset / Speed, bStopRequested);
+
+            // Recorded timeline anchored at the start of this pass
+            HandleMessage(Base + Offset, Msg.Data, Msg.Size);
+            TimelineEnd = Base + Offset;
+            ++NumEvents;
+        }
+
+        const double Elapsed = FPlatformTime::Seconds() - WallStart;
+        UE_LOG(LogUnrealMidi, Display, TEXT("[Replay] %s: %lld event(s) in %.3fs (%.0f ev/s, speed %s)"),
+            *DeviceName, NumEvents, Elapsed, Elapsed > 0.0 ? NumEvents / Elapsed : 0.0,
+            Speed > 0.f ? *FString::Printf(TEXT("x%.2f"), Speed) : TEXT("max"));
+    }
+    while (bLoop && !bStopRequested);
+
+    bFinished = true;
+    return 0;
+}
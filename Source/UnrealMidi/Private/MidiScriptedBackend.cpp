@@ -0,0 +1,134 @@
+#include "MidiScriptedBackend.h"
+#include "Algo/StableSort.h"
+#include "Algo/BinarySearch.h"
+#include "Misc/FileHelper.h"
+#include "UnrealMidiLog.h"
+
+FMidiScriptedBackend::FMidiScriptedBackend(TArray<FScriptedMessage> InScript)
+    : Script(MoveTemp(InScript))
+{
+    Algo::StableSortBy(Script, &FScriptedMessage::TimeSeconds);
+}
+
+bool FMidiScriptedBackend::LoadScript(const FString& Text)
+{
+    TArray<FString> Lines;
+    Text.ParseIntoArrayLines(Lines, false);
+
+    TArray<FScriptedMessage> Parsed;
+    for (int32 LineNo = 0; LineNo < Lines.Num(); ++LineNo)
+    {
+        FString Line = Lines[LineNo];
+        int32 Hash = INDEX_NONE;
+        if (Line.FindChar(TEXT('#'), Hash))
+            Line.LeftInline(Hash);
+        Line.TrimStartAndEndInline();
+        if (Line.IsEmpty())
+            continue;
+
+        TArray<FString> Tokens;
+        Line.ParseIntoArrayWS(Tokens);
+
+        FScriptedMessage Msg;
+        bool bOk = Tokens.Num() >= 2 && LexTryParseString(Msg.TimeSeconds, *Tokens[0]);
+        const int32 Digits = bOk ? Tokens[1].Len() : 0;    // 2 = bytes, 8 = UMP words; no mixing
+        bOk = bOk && (Digits == 2 || Digits == 8);
+        for (int32 i = 1; bOk && i < Tokens.Num(); ++i)
+        {
+            const FString& Tok = Tokens[i];
+            bOk = Tok.Len() == Digits;
+            for (int32 c = 0; bOk && c < Digits; ++c)
+                bOk = FChar::IsHexDigit(Tok[c]);
+            if (!bOk)
+                break;
+            if (Digits == 2)
+                Msg.Bytes.Add(uint8(FParse::HexNumber(*Tok)));
+            else
+                Msg.Words.Add(uint32(FParse::HexNumber64(*Tok)));
+        }
+
+        if (!bOk)
+        {
+            UE_LOG(LogUnrealMidi, Warning, TEXT("[Scripted] line %d: expected '<seconds> <hex bytes>', got '%s'"), LineNo + 1, *Lines[LineNo]);
+            return false;
+        }
+        Parsed.Add(MoveTemp(Msg));
+    }
+
+    Algo::StableSortBy(Parsed, &FScriptedMessage::TimeSeconds);
+    Script = MoveTemp(Parsed);
+    NextIndex = 0;
+    return true;
+}
+
+bool FMidiScriptedBackend::LoadScriptFile(const FString& Path)
+{
+    FString Text;
+    if (!FFileHelper::LoadFileToString(Text, *Path))
+    {
+        UE_LOG(LogUnrealMidi, Warning, TEXT("[Scripted] cannot read '%s'"), *Path);
+        return false;
+    }
+    return LoadScript(Text);
+}
+
+void FMidiScriptedBackend::AddPackets(double TimeSeconds, TArrayView<const uint32> Words)
+{
+    FScriptedMessage Msg;
+    Msg.TimeSeconds = TimeSeconds;
+    Msg.Words = Words;
+
+    const int32 At = Algo::UpperBoundBy(Script, TimeSeconds, &FScriptedMessage::TimeSeconds);
+    Script.Insert(MoveTemp(Msg), At);
+}
+
+void FMidiScriptedBackend::AddMessage(double TimeSeconds, TArrayView<const uint8> Bytes)
+{
+    FScriptedMessage Msg;
+    Msg.TimeSeconds = TimeSeconds;
+    Msg.Bytes = Bytes;
+
+    // Keep sorted; stable for equal times so insertion order is preserved
+    const int32 At = Algo::UpperBoundBy(Script, TimeSeconds, &FScriptedMessage::TimeSeconds);
+    Script.Insert(MoveTemp(Msg), At);
+}
+
+bool FMidiScriptedBackend::Open(const FString&, FMessageSink InSink)
+{
+    Sink = MoveTemp(InSink);
+    bOpen = true;
+    return true;
+}
+
+void FMidiScriptedBackend::Close()
+{
+    bOpen = false;
+    Sink = nullptr;
+}
+
+void FMidiScriptedBackend::Inject(TArrayView<const uint8> Bytes, double Now)
+{
+    if (bOpen && Bytes.Num() > 0)
+        Sink(Now, Bytes.GetData(), Bytes.Num(), 0.0);
+}
+
+void FMidiScriptedBackend::InjectUmp(TArrayView<const uint32> Words, double Now)
+{
+    if (bOpen && UmpSink && Words.Num() > 0)
+        UmpSink(Now, Words.GetData(), Words.Num(), 0.0);
+}
+
+int32 FMidiScriptedBackend::Pump(double UpToSeconds)
+{
+    int32 Delivered = 0;
+    while (bOpen && NextIndex < Script.Num() && Script[NextIndex].TimeSeconds <= UpToSeconds)
+    {
+        const FScriptedMessage& Msg = Script[NextIndex++];
+        if (Msg.Words.Num() > 0)
+            InjectUmp(Msg.Words, Msg.TimeSeconds);
+        else
+            Inject(Msg.Bytes, Msg.TimeSeconds);
+        ++Delivered;
+    }
+    return Delivered;
+}
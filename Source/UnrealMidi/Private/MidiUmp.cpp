@@ -0,0 +1,159 @@
+#include "MidiUmp.h"
+
+namespace MidiUmp
+{
+    int32 GetWordCount(uint32 Word0)
+    {
+        static constexpr int32 Words[16] = { 1, 1, 1, 2, 2, 4, 1, 1, 2, 2, 2, 3, 3, 4, 4, 4 };
+        return Words[Word0 >> 28];
+    }
+
+    uint32 Upscale(uint32 Value, int32 SrcBits, int32 DstBits)
+    {
+        if (SrcBits >= DstBits)
+            return Value >> (SrcBits - DstBits);
+
+        const int32 ScaleBits = DstBits - SrcBits;
+        uint64 Shifted = uint64(Value) << ScaleBits;
+        const uint32 SrcCenter = 1u << (SrcBits - 1);
+        if (Value <= SrcCenter)
+            return uint32(Shifted);
+
+        // Above center: repeat the lower bits to fill so that max maps to max
+        const int32 RepeatBits = SrcBits - 1;
+        uint64 Repeat = Value & ((1u << RepeatBits) - 1);
+        Repeat = ScaleBits > RepeatBits ? Repeat << (ScaleBits - RepeatBits) : Repeat >> (RepeatBits - ScaleBits);
+        while (Repeat != 0)
+        {
+            Shifted |= Repeat;
+            Repeat >>= RepeatBits;
+        }
+        return uint32(Shifted);
+    }
+
+    int32 FromMidi1(const uint8* Data, int32 Size, uint8 Group, uint32 OutWords[2])
+    {
+        if (!Data || Size < 2 || Data[0] < 0x80 || Data[0] >= 0xF0)
+            return 0;
+
+        const uint8 Status = Data[0] & 0xF0;
+        const uint8 D1 = Data[1] & 0x7F;
+        const uint8 D2 = Size >= 3 ? Data[2] & 0x7F : 0;
+        uint32 W0 = (uint32(EMessageType::Midi2Voice) << 28) | (uint32(Group & 0x0F) << 24) | (uint32(Data[0]) << 16);
+        uint32 W1 = 0;
+
+        switch (Status)
+        {
+            case 0x80:
+            case 0x90:
+                if (Size < 3) return 0;
+                W0 |= uint32(D1) << 8;
+                W1 = Upscale(D2, 7, 16) << 16;
+                if (Status == 0x90 && D2 == 0)   // MIDI 1 note-on velocity 0 is a note-off
+                {
+                    W0 = (W0 & ~0x00F00000u) | 0x00800000u;
+                    W1 = Upscale(64, 7, 16) << 16;
+                }
+                break;
+            case 0xA0:
+            case 0xB0:
+                if (Size < 3) return 0;
+                W0 |= uint32(D1) << 8;
+                W1 = Upscale(D2, 7, 32);
+                break;
+            case 0xC0:
+                W1 = uint32(D1) << 24;
+                break;
+            case 0xD0:
+                W1 = Upscale(D1, 7, 32);
+                break;
+            case 0xE0:
+                if (Size < 3) return 0;
+                W1 = Upscale((uint32(D2) << 7) | D1, 14, 32);
+                break;
+            default:
+                return 0;
+        }
+
+        OutWords[0] = W0;
+        OutWords[1] = W1;
+        return 2;
+    }
+
+    int32 ToMidi1(const uint32* Words, int32 NumWords, uint8 OutBytes[3])
+    {
+        if (!Words || NumWords < 1 || NumWords < GetWordCount(Words[0]))
+            return 0;
+
+        const uint32 W0 = Words[0];
+        const uint8 StatusByte = uint8((W0 >> 16) & 0xFF);
+
+        switch (GetType(W0))
+        {
+            case EMessageType::System:
+            {
+                OutBytes[0] = StatusByte;
+                OutBytes[1] = GetByte2(W0) & 0x7F;
+                OutBytes[2] = GetByte3(W0) & 0x7F;
+                switch (StatusByte)
+                {
+                    case 0xF1: case 0xF3: return 2;
+                    case 0xF2:            return 3;
+                    default:              return StatusByte >= 0xF0 ? 1 : 0;
+                }
+            }
+
+            case EMessageType::Midi1Voice:
+            {
+                OutBytes[0] = StatusByte;
+                OutBytes[1] = GetByte2(W0) & 0x7F;
+                OutBytes[2] = GetByte3(W0) & 0x7F;
+                const uint8 Status = StatusByte & 0xF0;
+                return (Status == 0xC0 || Status == 0xD0) ? 2 : 3;
+            }
+
+            case EMessageType::Midi2Voice:
+            {
+                const uint32 W1 = Words[1];
+                const uint8 Status = StatusByte & 0xF0;
+                OutBytes[0] = StatusByte;
+                OutBytes[1] = GetByte2(W0) & 0x7F;
+                switch (Status)
+                {
+                    case 0x80:
+                        OutBytes[2] = uint8(Downscale(W1 >> 16, 16, 7));
+                        return 3;
+                    case 0x90:
+                    {
+                        // MIDI 2 allows velocity 0 on a note-on; MIDI 1 would read it as a note-off
+                        const uint8 Vel = uint8(Downscale(W1 >> 16, 16, 7));
+                        OutBytes[2] = Vel == 0 ? 1 : Vel;
+                        return 3;
+                    }
+                    case 0xA0:
+                    case 0xB0:
+                        OutBytes[2] = uint8(Downscale(W1, 32, 7));
+                        return 3;
+                    case 0xC0:
+                        OutBytes[1] = uint8((W1 >> 24) & 0x7F);
+                        return 2;
+                    case 0xD0:
+                        OutBytes[1] = uint8(Downscale(W1, 32, 7));
+                        return 2;
+                    case 0xE0:
+                    {
+                        const uint32 Bend14 = Downscale(W1, 32, 14);
+                        OutBytes[1] = uint8(Bend14 & 0x7F);
+                        OutBytes[2] = uint8(Bend14 >> 7);
+                        return 3;
+                    }
+                    default:
+                        return 0;
+                }
+            }
+
+            default:
+                return 0;
+        }
+    }
+}
@@ -0,0 +1,218 @@
+// UnrealMidiPipelineTests.cpp
+//
+// Automation tests for the input pipeline (decode -> filter -> game-thread dispatch) without hardware:
+// each test opens a scripted input through OpenInputDevice, injects raw bytes with explicit timestamps
+// and checks what the subsystem broadcasts. Runs headless:
+//   UnrealEditor-Cmd <Project> -nullrhi -unattended -ExecCmds="Automation RunTests UnrealMidi.Pipeline; Quit"
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Async/TaskGraphInterfaces.h"
+#include "Engine/Engine.h"
+#include "MidiEventRing.h"
+#include "MidiScriptedBackend.h"
+#include "UnrealMidiSubsystem.h"
+
+namespace UnrealMidiTests
+{
+    constexpr EAutomationTestFlags Flags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+
+    /** A scripted input in the live pipeline; collects what OnMidiValueNative (fired with OnMidiValue) broadcasts */
+    class FScriptedInput
+    {
+    public:
+        explicit FScriptedInput(const FString& InName)
+            : Name(InName)
+        {
+            Midi = GEngine ? GEngine->GetEngineSubsystem<UUnrealMidiSubsystem>() : nullptr;
+            if (!Midi)
+                return;
+
+            TUniquePtr<FMidiScriptedBackend> Script = MakeUnique<FMidiScriptedBackend>();
+            Backend = Script.Get();
+            if (!Midi->OpenInputDevice(Name, MoveTemp(Script)).IsValid())
+            {
+                Backend = nullptr;
+                return;
+            }
+
+            Handle = Midi->OnMidiValueNative.AddLambda([this](const FMidiControlValue& V)
+            {
+                if (V.Device == Name)
+                    Values.Add(V);
+            });
+        }
+
+        ~FScriptedInput()
+        {
+            if (Midi)
+            {
+                Midi->OnMidiValueNative.Remove(Handle);
+                Midi->CloseInputDevice(Name);
+            }
+        }
+
+        bool IsValid() const { return Backend != nullptr; }
+
+        /** The device's event ring, as MetaSound nodes read it */
+        const FMidiEventRing& GetRing() const { return Midi->GetEventRing(Name); }
+
+        /** Delivers one message stamped Time, then runs the game-thread dispatch so nothing is coalesced */
+        void Send(const TArray<uint8>& Bytes, double Time)
+        {
+            Queue(Bytes, Time);
+            Pump();
+        }
+
+        /** Delivers one message; it waits in the dispatch queue (and may coalesce) until Pump */
+        void Queue(const TArray<uint8>& Bytes, double Time)
+        {
+            Backend->Inject(Bytes, Time);
+        }
+
+        void Pump()
+        {
+            FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+        }
+
+        const FString Name;
+        TArray<FMidiControlValue> Values;
+
+    private:
+        UUnrealMidiSubsystem* Midi = nullptr;
+        FMidiScriptedBackend* Backend = nullptr;
+        FDelegateHandle Handle;
+    };
+}
+
+using namespace UnrealMidiTests;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealMidiFilterTest, "UnrealMidi.Pipeline.Filter", UnrealMidiTests::Flags)
+bool FUnrealMidiFilterTest::RunTest(const FString& Parameters)
+{
+    FScriptedInput In(TEXT("UnrealMidiTest Filter"));
+    if (!TestTrue(TEXT("Scripted input opened"), In.IsValid()))
+        return false;
+
+    // Default settings: 2% to engage from idle, 0.4% while active, idle after 120 ms
+    In.Send({ 0xB0, 7, 64 }, 1.000);   // engages
+    In.Send({ 0xB0, 7, 65 }, 1.010);   // active: one step passes
+    In.Send({ 0xB0, 7, 65 }, 1.020);   // no change
+    In.Send({ 0xB0, 7, 66 }, 2.000);   // idle again: one step is below the engage threshold
+    In.Send({ 0xB0, 7, 70 }, 2.010);   // 5 steps from the last accepted value
+
+    if (!TestEqual(TEXT("Values through the filter"), In.Values.Num(), 3))
+        return false;
+
+    TestEqual(TEXT("First value"), In.Values[0].Value, 64.f / 127.f, KINDA_SMALL_NUMBER);
+    TestEqual(TEXT("Step while active"), In.Values[1].Value, 65.f / 127.f, KINDA_SMALL_NUMBER);
+    TestEqual(TEXT("Move after idle"), In.Values[2].Value, 70.f / 127.f, KINDA_SMALL_NUMBER);
+    TestEqual(TEXT("Id"), In.Values[0].Id, FString(TEXT("IN:UnrealMidiTest Filter:CC:1:7")));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealMidiDigitalSuppressionTest, "UnrealMidi.Pipeline.DigitalSuppression", UnrealMidiTests::Flags)
+bool FUnrealMidiDigitalSuppressionTest::RunTest(const FString& Parameters)
+{
+    FScriptedInput In(TEXT("UnrealMidiTest Suppression"));
+    if (!TestTrue(TEXT("Scripted input opened"), In.IsValid()))
+        return false;
+
+    // A button edge mutes the device's other controls for 80 ms; the button itself stays live
+    In.Send({ 0xB0, 1, 127 }, 1.000);
+    In.Send({ 0xB0, 2, 64 }, 1.030);   // neighbour inside the window: dropped
+    In.Send({ 0xB0, 1, 0 }, 1.050);    // the button's release
+    In.Send({ 0xB0, 2, 64 }, 1.250);   // window over
+
+    if (!TestEqual(TEXT("Values through the filter"), In.Values.Num(), 3))
+        return false;
+
+    TestEqual(TEXT("Press"), In.Values[0].ControlId, 1);
+    TestEqual(TEXT("Press value"), In.Values[0].Value, 1.f);
+    TestEqual(TEXT("Release"), In.Values[1].ControlId, 1);
+    TestEqual(TEXT("Release value"), In.Values[1].Value, 0.f);
+    TestEqual(TEXT("Neighbour after the window"), In.Values[2].ControlId, 2);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealMidiCoalescingTest, "UnrealMidi.Pipeline.Coalescing", UnrealMidiTests::Flags)
+bool FUnrealMidiCoalescingTest::RunTest(const FString& Parameters)
+{
+    FScriptedInput In(TEXT("UnrealMidiTest Coalescing"));
+    if (!TestTrue(TEXT("Scripted input opened"), In.IsValid()))
+        return false;
+
+    // A CC button's press and release within one drain both arrive, in order
+    In.Queue({ 0xB0, 1, 127 }, 1.000);
+    In.Queue({ 0xB0, 1, 0 }, 1.010);
+    In.Pump();
+
+    // A fader's moves within one drain merge into the last
+    In.Queue({ 0xB0, 7, 64 }, 2.000);
+    In.Queue({ 0xB0, 7, 80 }, 2.010);
+    In.Queue({ 0xB0, 7, 96 }, 2.020);
+    In.Pump();
+
+    if (!TestEqual(TEXT("Values dispatched"), In.Values.Num(), 3))
+        return false;
+
+    TestEqual(TEXT("Press"), In.Values[0].Value, 1.f);
+    TestEqual(TEXT("Release"), In.Values[1].Value, 0.f);
+    TestEqual(TEXT("Fader"), In.Values[2].ControlId, 7);
+    TestEqual(TEXT("Latest fader value"), In.Values[2].Value, 96.f / 127.f, KINDA_SMALL_NUMBER);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealMidiChordRingTest, "UnrealMidi.Pipeline.ChordRing", UnrealMidiTests::Flags)
+bool FUnrealMidiChordRingTest::RunTest(const FString& Parameters)
+{
+    FScriptedInput In(TEXT("UnrealMidiTest Chord"));
+    if (!TestTrue(TEXT("Scripted input opened"), In.IsValid()))
+        return false;
+
+    // Each note is a digital edge; the second one is inside the first one's suppression window
+    const FMidiEventRing& Ring = In.GetRing();
+    uint64 Cursor = Ring.GetWriteCount();
+    In.Send({ 0x90, 60, 100 }, 1.000);
+    In.Send({ 0x90, 64, 100 }, 1.001);
+
+    FMidiTimedEvent Events[8];
+    const int32 Num = Ring.Read(Cursor, TNumericLimits<double>::Max(), Events, UE_ARRAY_COUNT(Events));
+    if (!TestEqual(TEXT("Both notes in the event ring"), Num, 2))
+        return false;
+
+    TestTrue(TEXT("First is a note-on"), Events[0].Kind == FMidiTimedEvent::EKind::NoteOn);
+    TestEqual(TEXT("First note"), int32(Events[0].Number), 60);
+    TestTrue(TEXT("Second is a note-on"), Events[1].Kind == FMidiTimedEvent::EKind::NoteOn);
+    TestEqual(TEXT("Second note"), int32(Events[1].Number), 64);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealMidiProgramChangeBypassTest, "UnrealMidi.Pipeline.ProgramChangeBypass", UnrealMidiTests::Flags)
+bool FUnrealMidiProgramChangeBypassTest::RunTest(const FString& Parameters)
+{
+    FScriptedInput In(TEXT("UnrealMidiTest ProgramChange"));
+    if (!TestTrue(TEXT("Scripted input opened"), In.IsValid()))
+        return false;
+
+    // Program changes skip suppression and hysteresis: they pass inside a button's window, and repeats pass too
+    In.Send({ 0xB0, 1, 127 }, 1.000);
+    In.Send({ 0xC0, 5 }, 1.010);
+    In.Send({ 0xC0, 5 }, 1.020);
+
+    if (!TestEqual(TEXT("Values through the filter"), In.Values.Num(), 3))
+        return false;
+
+    for (int32 i = 1; i < 3; ++i)
+    {
+        TestTrue(TEXT("Type is PC"), In.Values[i].Type == EMidiMessageType::PC);
+        TestEqual(TEXT("Program"), In.Values[i].ControlId, 5);
+        TestEqual(TEXT("Id"), In.Values[i].Id, FString(TEXT("IN:UnrealMidiTest ProgramChange:PC:1:5")));
+    }
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
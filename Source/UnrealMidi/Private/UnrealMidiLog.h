@@ -0,0 +1,5 @@
+#pragma once
+#include "CoreMinimal.h"
+
+// The module's log category, defined in UnrealMidiStartup.cpp
+DECLARE_LOG_CATEGORY_EXTERN(LogUnrealMidi, Log, All);
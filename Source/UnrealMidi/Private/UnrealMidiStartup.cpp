@@ -1,17 +1,31 @@
-DEFINE_LOG_CATEGORY_STATIC(LogUnrealMidi, Log, All);
+#include "IInputDeviceModule.h"
+#include "MidiInputKeys.h"
+#include "MidiKeyInputDevice.h"
+#include "UnrealMidiLog.h"
 
-class FUnrealMidiModule : public IModuleInterface
+DEFINE_LOG_CATEGORY(LogUnrealMidi);
+
+// Also an input device module: the application creates FMidiKeyInputDevice the first time it polls input
+class FUnrealMidiModule : public IInputDeviceModule
 {
 public:
     virtual void StartupModule() override
     {
+        IInputDeviceModule::StartupModule();
+        FMidiInputKeys::Get().RegisterSavedControls();
         UE_LOG(LogUnrealMidi, Display, TEXT("[UnrealMidi] StartupModule ok."));
     }
 
     virtual void ShutdownModule() override
     {
+        IInputDeviceModule::ShutdownModule();
         UE_LOG(LogUnrealMidi, Display, TEXT("[UnrealMidi] ShutdownModule."));
     }
+
+    virtual TSharedPtr<class IInputDevice> CreateInputDevice(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler) override
+    {
+        return MakeShared<FMidiKeyInputDevice>(InMessageHandler);
+    }
 };
 
 IMPLEMENT_MODULE(FUnrealMidiModule, UnrealMidi)
@@ -0,0 +1,73 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Animation/AnimNodeBase.h"
+#include "BoneContainer.h"
+#include "MidiControlStore.h"
+#include "AnimNode_MidiControls.generated.h"
+
+UENUM(BlueprintType)
+enum class EMidiAnimTarget : uint8
+{
+    Curve,              // sets CurveName
+    BoneRotation,       // rotates Bone about Axis by the value in degrees (local space, on top of the input pose)
+    BoneTranslation     // moves Bone along Axis by the value in cm (local space, on top of the input pose)
+};
+
+/** One control driving one curve or bone */
+USTRUCT(BlueprintType)
+struct UNREALMIDI_API FMidiAnimControlBinding
+{
+    GENERATED_BODY()
+
+    /** "IN:Device:CC:1:74" / "IN:Device:NOTE:10:36" (channels 1..16) */
+    UPROPERTY(EditAnywhere, Category="MIDI")
+    FString ControlId;
+
+    UPROPERTY(EditAnywhere, Category="MIDI")
+    EMidiAnimTarget Target = EMidiAnimTarget::Curve;
+
+    UPROPERTY(EditAnywhere, Category="MIDI", meta=(EditCondition="Target==EMidiAnimTarget::Curve", EditConditionHides))
+    FName CurveName;
+
+    UPROPERTY(EditAnywhere, Category="MIDI", meta=(EditCondition="Target!=EMidiAnimTarget::Curve", EditConditionHides))
+    FBoneReference Bone;
+
+    UPROPERTY(EditAnywhere, Category="MIDI", meta=(EditCondition="Target!=EMidiAnimTarget::Curve", EditConditionHides))
+    FVector Axis = FVector::UpVector;
+
+    /** The control's 0..1 maps onto OutputMin..OutputMax */
+    UPROPERTY(EditAnywhere, Category="MIDI")
+    float OutputMin = 0.f;
+
+    UPROPERTY(EditAnywhere, Category="MIDI")
+    float OutputMax = 1.f;
+
+    /** Used until the control first moves */
+    UPROPERTY(EditAnywhere, Category="MIDI")
+    float DefaultValue = 0.f;
+
+    FMidiControlHandle Handle;
+};
+
+/**
+ * Applies MIDI controls to curves and bones inside the anim graph. The controls' handles are resolved
+ * once on initialise; Evaluate_AnyThread reads the seqlocked latest values directly, so a value reaches
+ * the pose on the worker thread that evaluates it, with no game-thread event or anim-instance variable.
+ */
+USTRUCT(BlueprintInternalUseOnly)
+struct UNREALMIDI_API FAnimNode_MidiControls : public FAnimNode_Base
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Links")
+    FPoseLink Source;
+
+    UPROPERTY(EditAnywhere, Category="MIDI")
+    TArray<FMidiAnimControlBinding> Bindings;
+
+    virtual void Initialize_AnyThread(const FAnimationInitializeContext& Context) override;
+    virtual void CacheBones_AnyThread(const FAnimationCacheBonesContext& Context) override;
+    virtual void Update_AnyThread(const FAnimationUpdateContext& Context) override;
+    virtual void Evaluate_AnyThread(FPoseContext& Output) override;
+    virtual void GatherDebugData(FNodeDebugData& DebugData) override;
+};
@@ -0,0 +1,80 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "MidiSeqLock.h"
+#include "MidiClock.generated.h"
+
+UENUM(BlueprintType)
+enum class EMidiTransport : uint8
+{
+    Start,      // 0xFA: from the top
+    Continue,   // 0xFB: from the song position
+    Stop        // 0xFC
+};
+
+/** A device's MIDI clock as of one instant */
+USTRUCT(BlueprintType)
+struct UNREALMIDI_API FMidiClockState
+{
+    GENERATED_BODY()
+
+    /** Filtered tempo; 0 until two clocks arrived */
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Clock") float Bpm = 0.f;
+
+    /** Quarter notes since Start (or the song position), extrapolated between clocks */
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Clock") double Beat = 0.0;
+
+    /** Fractional part of Beat: 0 on the beat */
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Clock") float BeatPhase = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Clock") bool bPlaying = false;
+
+    /** The loop has settled (recent clocks within 10% of the prediction) */
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Clock") bool bLocked = false;
+};
+
+/**
+ * Tracks 24 PPQN MIDI clock on the ingest thread. A second-order delay-locked loop filters the tick
+ * times, so the tempo doesn't jitter with USB / driver timing, and the phase between ticks is
+ * extrapolated from the filtered period. Start / Continue / Stop / Song Position are followed too.
+ *
+ * One writer (the device's decode thread); GetState reads a seqlocked snapshot from any thread.
+ */
+class UNREALMIDI_API FMidiClockTracker
+{
+public:
+    /** Loop bandwidth in Hz: lower = steadier tempo, slower to follow tempo changes */
+    void SetBandwidth(float InHz) { BandwidthHz = FMath::Clamp(InHz, 0.05f, 10.f); }
+
+    /**
+     * Decode thread. True if Data was a clock / transport / song position message (consumed);
+     * OutTransport is set when the transport changed.
+     */
+    bool HandleMessage(const uint8* Data, int32 Size, double Time, TOptional<EMidiTransport>& OutTransport);
+
+    /** Any thread; Now on the FPlatformTime::Seconds clock */
+    FMidiClockState GetState(double Now) const;
+
+    /** Forget tempo and transport; only while no device writes to it */
+    void Reset();
+
+private:
+    struct FSnapshot
+    {
+        double Period = 0.0;        // seconds per clock (filtered); 0 = unknown
+        double TickTime = 0.0;      // filtered time of the last clock
+        int64  SongTicks = -1;      // clocks since the song position; -1 = waiting for the first
+        uint8  bPlaying = 0;
+        uint8  bLocked = 0;
+    };
+
+    void Tick(double Time);
+
+    TMidiSeqLock<FSnapshot> State;
+    float BandwidthHz = 1.f;
+
+    // Loop state (decode thread)
+    double FirstTime = 0.0;     // previous raw clock while the period is unknown
+    double Expected = 0.0;      // predicted time of the next clock
+    double Period = 0.0;
+    int32  GoodTicks = 0;
+};
@@ -0,0 +1,65 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "MidiSeqLock.h"
+
+/** Latest accepted value of one control */
+struct FMidiControlSample
+{
+    float  Value = 0.f;
+    double Time = 0.0;      // driver timestamp (FPlatformTime); 0 = never received
+};
+
+using FMidiControlSlot = TMidiSeqLock<FMidiControlSample>;
+
+/**
+ * Resolved once (FMidiControlStore::GetSlot / UUnrealMidiSubsystem::ResolveControl), then read from any
+ * thread without locks or lookups. Stays valid for the subsystem's lifetime, across reconnects.
+ */
+struct FMidiControlHandle
+{
+    const FMidiControlSlot* Slot = nullptr;
+
+    bool IsValid() const { return Slot != nullptr; }
+
+    /** False if unresolved or nothing received yet (OutValue is then left alone) */
+    bool Read(float& OutValue) const
+    {
+        if (!Slot)
+            return false;
+        const FMidiControlSample S = Slot->Read();
+        if (S.Time <= 0.0)
+            return false;
+        OutValue = S.Value;
+        return true;
+    }
+};
+
+/**
+ * Latest value of every CC and note on channels 1..16 of one device, one seqlock per control so a
+ * reader copies 12 bytes, not the table. Written by the device's decode thread after filtering; the
+ * slots are allocated up front, so handles never move.
+ */
+class UNREALMIDI_API FMidiControlStore
+{
+public:
+    enum class EKind : uint8 { Cc, Note, Num };
+
+    static constexpr int32 NumChannels = 16;
+    static constexpr int32 NumNumbers = 128;
+
+    FMidiControlStore();
+
+    /** Decode thread (or the game thread once the device is closed) */
+    void Write(EKind Kind, int32 Chan, int32 Num, float Value, double Time);
+
+    /** nullptr outside channels 1..16 / numbers 0..127 */
+    const FMidiControlSlot* GetSlot(EKind Kind, int32 Chan, int32 Num) const;
+
+    /** Back to "never received"; only while no device writes to it */
+    void Reset();
+
+private:
+    static int32 SlotIndex(EKind Kind, int32 Chan, int32 Num);
+
+    TUniquePtr<FMidiControlSlot[]> Slots;
+};
@@ -0,0 +1,42 @@
+#pragma once
+#include "CoreMinimal.h"
+#include <atomic>
+
+/** One accepted CC / note event, as consumers off the game thread see it */
+struct FMidiTimedEvent
+{
+    enum class EKind : uint8 { Cc, NoteOn, NoteOff };
+
+    double Time = 0.0;      // driver timestamp (FPlatformTime)
+    float  Value = 0.f;     // CC 0..1 / note velocity 0..1
+    int16  Channel = 0;     // 1-based
+    uint8  Number = 0;
+    EKind  Kind = EKind::Cc;
+};
+
+/**
+ * Broadcast ring of one device's events: the decode thread appends without waiting, any number of readers
+ * (MetaSound operators on the audio render thread, ...) keep their own cursor. A reader that falls more than
+ * Capacity events behind skips what was overwritten.
+ */
+class UNREALMIDI_API FMidiEventRing
+{
+public:
+    static constexpr uint32 Capacity = 1024;
+
+    /** Decode thread (single writer) */
+    void Push(const FMidiTimedEvent& Event);
+
+    /** Cursor that only sees events pushed from now on */
+    uint64 GetWriteCount() const { return Count.load(std::memory_order_acquire); }
+
+    /**
+     * Copies up to Max events from Cursor on that are older than Before, and moves Cursor past them.
+     * Returns how many were copied. Any thread, no locks.
+     */
+    int32 Read(uint64& Cursor, double Before, FMidiTimedEvent* Out, int32 Max) const;
+
+private:
+    std::atomic<uint64> Count { 0 };    // events ever pushed; published after the event
+    FMidiTimedEvent Events[Capacity];
+};
@@ -0,0 +1,102 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "MidiMappedFile.h"
+#include "MidiRecording.h"
+
+// Standard MIDI File (type 0/1) support.
+// Export defaults: 960 PPQ at a fixed 120 BPM, so one second is exactly 1920 ticks.
+namespace MidiFile
+{
+    inline constexpr uint16 ExportDivision = 960;
+    inline constexpr uint32 ExportTempo    = 500000; // microseconds per quarter note
+}
+
+/**
+ * Zero-copy SMF parser over a memory-mapped file.
+ * Only the conductor track's tempo events are read on Open(); every track is indexed
+ * (one seek point per beat) the first time playback seeks into it, and events are decoded
+ * on demand while merging tracks. Channel messages with an explicit status byte point
+ * straight into the mapping; running status and SysEx go through a small scratch buffer.
+ */
+class UNREALMIDI_API FMidiFileReader : public IMidiReplaySource
+{
+public:
+    bool Open(const FString& FilePath);
+    void Close();
+
+    bool IsOpen() const { return File.IsOpen(); }
+    int32 GetFormat() const { return Format; }
+    int32 GetNumTracks() const { return Tracks.Num(); }
+    double GetDurationSeconds();
+
+    double TicksToSeconds(int64 Tick) const;
+    int64 SecondsToTicks(double Seconds) const;
+
+    // IMidiReplaySource
+    virtual const FString& GetDeviceName() const override { return DeviceName; }
+    virtual bool Seek(double Seconds) override;
+    virtual bool Next(FMidiRecordedMessage& Out) override;
+
+private:
+    struct FSeekPoint
+    {
+        int64 Tick = 0;
+        int64 Offset = 0;       // at the delta-time of the next event
+        uint8 RunningStatus = 0;
+    };
+
+    struct FTrack
+    {
+        int64 Begin = 0;
+        int64 End = 0;
+        int64 LastTick = 0;
+        bool  bIndexed = false;
+        TArray<FSeekPoint> SeekPoints;
+    };
+
+    struct FCursor
+    {
+        int64 Pos = 0;          // at the next event's status/data (delta already consumed)
+        int64 Tick = 0;         // absolute tick of that event
+        uint8 RunningStatus = 0;
+        bool  bDone = true;
+    };
+
+    struct FTempoPoint
+    {
+        int64  Tick = 0;
+        double Seconds = 0.0;
+        uint32 MicrosPerQuarter = MidiFile::ExportTempo;
+    };
+
+    /** Reads one event at C.Pos into Out (unless null); OutMetaType is INDEX_NONE for non-meta events */
+    bool ReadEvent(FCursor& C, const FTrack& Track, FMidiRecordedMessage* Out, int32& OutMetaType);
+    bool ReadDelta(FCursor& C, const FTrack& Track) const;
+    bool ReadVlq(int64& Pos, int64 End, uint32& Out) const;
+
+    void BuildTempoMap();
+    void IndexTrack(FTrack& Track);
+
+    FMidiMappedFile File;
+    FString DeviceName;
+
+    int32  Format = 0;
+    uint16 Division = MidiFile::ExportDivision;
+    double SmpteTicksPerSecond = 0.0; // > 0 for SMPTE time division
+
+    TArray<FTrack> Tracks;
+    TArray<FCursor> Cursors;
+    TArray<FTempoPoint> TempoMap;
+
+    TArray<uint8> Scratch;
+};
+
+/** Writes SMF type 0 files with running-status compression */
+class UNREALMIDI_API FMidiFileWriter
+{
+public:
+    /** Converts a .umidirec capture into a single-track Standard MIDI File */
+    static bool ExportRecording(const FString& RecordingPath, const FString& MidiPath);
+
+    static bool WriteType0(const FString& TrackName, IMidiReplaySource& Source, const FString& MidiPath);
+};
@@ -3,6 +3,15 @@
 #include "MidiTypes.h" // FMidiControlValue
 #include "MidiFilter.generated.h"
 
+// Extrapolation of a continuous control to a future time (see FMidiPredictor)
+UENUM(BlueprintType)
+enum class EMidiPredictMode : uint8
+{
+    Off,
+    ConstantVelocity,   // slope of the last two accepted values
+    OneEuro             // slope low-passed with a speed-adaptive cutoff (steadier on slow moves)
+};
+
 // Tunables (per device)
 USTRUCT(BlueprintType)
 struct UNREALMIDI_API FMidiFilterSettings
@@ -27,6 +36,26 @@ struct UNREALMIDI_API FMidiFilterSettings
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Filter")
     float SuppressOthersAfterDigital = 0.08f; // seconds (80 ms)
+
+    // Predictor used by GetPredictedValue (Off = latest accepted value).
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Filter|Prediction")
+    EMidiPredictMode Predict = EMidiPredictMode::Off;
+
+    // Never extrapolate further than this past the last event (s).
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Filter|Prediction")
+    float PredictMaxLookahead = 0.04f;   // 40 ms, about two frames
+
+    // Time constant of the velocity's decay: bounds the overshoot and settles back once the control stops (s).
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Filter|Prediction")
+    float PredictDecaySeconds = 0.05f;
+
+    // One-Euro: velocity cutoff at rest (Hz); lower = steadier, laggier.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Filter|Prediction")
+    float PredictMinCutoff = 1.0f;
+
+    // One-Euro: cutoff increase per unit/s of speed; higher = follows fast moves sooner.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Filter|Prediction")
+    float PredictBeta = 0.5f;
 };
 
 // Per-control runtime state (keyed by control Id)
@@ -37,6 +66,11 @@ struct UNREALMIDI_API FMidiCtrlState
     bool   bActive = false;
     int8   LastSign = 0;
     double LastAnyEventTime = 0.0;
+
+    // Predictor (FPlatformTime clock; only fed with accepted values)
+    float  PredValue = 0.f;
+    float  PredVelocity = 0.f;  // units per second
+    double PredTime = 0.0;      // 0 = no sample yet
 };
 
 /// Stateless helper implementing Schmitt-trigger hysteresis with micro-debounce.
@@ -86,3 +120,55 @@ struct UNREALMIDI_API FMidiSchmittFilter
         return bPass;
     }
 };
+
+/// Latency compensation for continuous controls: the value lands mid-frame, the frame is presented later.
+/// Update() on every accepted value; Extrapolate() to the presentation time.
+struct UNREALMIDI_API FMidiPredictor
+{
+    static void Update(const FMidiFilterSettings& S, FMidiCtrlState& State, float Value, double Time)
+    {
+        const double Dt = Time - State.PredTime;
+        if (State.PredTime <= 0.0 || Dt > S.IdleSeconds)
+        {
+            // First move after idle: no slope yet
+            State.PredVelocity = 0.f;
+        }
+        else if (Dt > 1e-4)
+        {
+            const float Raw = float((Value - State.PredValue) / Dt);
+            if (S.Predict == EMidiPredictMode::OneEuro)
+            {
+                const float Cutoff = S.PredictMinCutoff + S.PredictBeta * FMath::Abs(State.PredVelocity);
+                const float Tau = 1.f / (2.f * PI * FMath::Max(Cutoff, 0.01f));
+                const float Alpha = float(Dt / (Dt + Tau));
+                State.PredVelocity = FMath::Lerp(State.PredVelocity, Raw, Alpha);
+            }
+            else
+            {
+                State.PredVelocity = Raw;
+            }
+        }
+        // else: same timestamp (burst), keep the slope and move the base
+
+        State.PredValue = Value;
+        State.PredTime = Time;
+    }
+
+    static float Extrapolate(const FMidiFilterSettings& S, const FMidiCtrlState& State, double TargetTime)
+    {
+        if (S.Predict == EMidiPredictMode::Off || State.PredTime <= 0.0 || TargetTime <= State.PredTime)
+            return State.PredValue;
+
+        // Distance covered by a velocity decaying with PredictDecaySeconds, up to the lookahead
+        const double Gap = TargetTime - State.PredTime;
+        const double Tau = FMath::Max(double(S.PredictDecaySeconds), 1e-3);
+        const double H = FMath::Min(Gap, double(S.PredictMaxLookahead));
+        double Offset = State.PredVelocity * Tau * (1.0 - FMath::Exp(-H / Tau));
+
+        // No new event for longer than the lookahead: the hand stopped, settle back to the last value
+        if (Gap > H)
+            Offset *= FMath::Exp(-(Gap - H) / Tau);
+
+        return FMath::Clamp(State.PredValue + float(Offset), 0.f, 1.f);
+    }
+};
@@ -0,0 +1,93 @@
+#pragma once
+#include "CoreMinimal.h"
+#include <atomic>
+#include "MidiHistory.generated.h"
+
+/** How SampleAt reconstructs a value between two received samples */
+UENUM(BlueprintType)
+enum class EMidiHistoryInterp : uint8
+{
+    Step,       // last received value (what LatestById would have said)
+    Linear,
+    Hermite     // cubic through the neighbours, for smooth curves from coarse 7-bit steps
+};
+
+/** Memory budget of one device's history slab: how many controls of each type, how many samples each */
+USTRUCT(BlueprintType)
+struct UNREALMIDI_API FMidiHistorySettings
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="UnrealMidi|History") int32 CcControls = 32;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="UnrealMidi|History") int32 CcDepth = 64;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="UnrealMidi|History") int32 NoteControls = 32;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="UnrealMidi|History") int32 NoteDepth = 16;
+
+    bool operator==(const FMidiHistorySettings& Other) const
+    {
+        return CcControls == Other.CcControls && CcDepth == Other.CcDepth
+            && NoteControls == Other.NoteControls && NoteDepth == Other.NoteDepth;
+    }
+    bool operator!=(const FMidiHistorySettings& Other) const { return !(*this == Other); }
+};
+
+/**
+ * Recent values of every CC / note of one device, for sampling at an arbitrary time. All rings live in
+ * one slab sized by FMidiHistorySettings; a control gets its ring the first time it moves (controls
+ * beyond the budget are not recorded). Timestamps are FPlatformTime::Seconds (driver time when known).
+ *
+ * The decode thread writes without locking; readers copy a ring and drop samples overwritten meanwhile.
+ */
+class UNREALMIDI_API FMidiValueHistory
+{
+public:
+    enum class EKind : uint8 { Cc, Note, Num };
+
+    /** Lays out the slab; only before the history is shared (readers never see it change size) */
+    void Configure(const FMidiHistorySettings& InSettings);
+    const FMidiHistorySettings& GetSettings() const { return Settings; }
+
+    /** Decode thread */
+    void Record(EKind Kind, int32 Chan, int32 Num, float Value, double Time);
+
+    /** Any thread. False if the control has no samples yet. */
+    bool SampleAt(EKind Kind, int32 Chan, int32 Num, double Time, EMidiHistoryInterp Interp, float& OutValue) const;
+
+    /** Any thread. Backward differences over the samples up to Time, in units per second (and per second²). */
+    bool GetDerivatives(EKind Kind, int32 Chan, int32 Num, double Time, float& OutVelocity, float& OutAcceleration) const;
+
+    /** Forget all controls (device closed); only while no device writes to it */
+    void Reset();
+
+private:
+    struct FSample
+    {
+        double Time;
+        float Value;
+    };
+
+    struct FRing
+    {
+        std::atomic<uint32> Count { 0 };    // samples ever written; published after the sample
+        int32 Offset = 0;                   // into Samples
+        int32 Depth = 0;
+    };
+
+    using FSnapshot = TArray<FSample, TInlineAllocator<64>>;
+
+    static uint32 MakeKey(EKind Kind, int32 Chan, int32 Num);
+    int32 FindRing(uint32 Key) const;
+    bool Snapshot(EKind Kind, int32 Chan, int32 Num, double Time, FSnapshot& Out) const;
+
+    FMidiHistorySettings Settings;
+    TArray<FSample> Samples;                // the slab
+    TUniquePtr<FRing[]> Rings;
+    int32 NumRings = 0;
+    int32 FirstRing[int32(EKind::Num) + 1] = {};
+    int32 NextRing[int32(EKind::Num)] = {}; // decode thread
+
+    // Open addressing, control key -> ring; the key is published after its ring index
+    TUniquePtr<std::atomic<uint32>[]> Keys;
+    TArray<int32> RingOfKey;
+    uint32 KeyMask = 0;
+};
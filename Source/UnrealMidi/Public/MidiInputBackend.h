@@ -0,0 +1,85 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * Where a device's raw bytes come from. FMidiInputDevice only decodes; the backend owns the
+ * port/driver and pushes every message into the sink, so the pipeline can be fed by RtMidi,
+ * a virtual port or a scripted fake without touching the decoder.
+ */
+class UNREALMIDI_API IMidiInputBackend
+{
+public:
+    /**
+     * Now: timestamp the pipeline sees (wall clock for live ports).
+     * DriverSeconds: wall-clock driver timestamp if known, 0 otherwise.
+     */
+    using FMessageSink = TFunction<void(double Now, const uint8* Data, int32 Size, double DriverSeconds)>;
+
+    /** Universal MIDI Packets (MIDI 2.0): whole packets of host-order 32-bit words */
+    using FUmpSink = TFunction<void(double Now, const uint32* Words, int32 NumWords, double DriverSeconds)>;
+
+    virtual ~IMidiInputBackend() = default;
+
+    /** Backends that can deliver UMP push it here; set before Open */
+    void SetUmpSink(FUmpSink InSink) { UmpSink = MoveTemp(InSink); }
+
+    /** Drop MIDI clock (and MTC) in the driver instead of waking the sink 24 times a beat; set before Open */
+    virtual void SetIgnoreTiming(bool bIgnore) {}
+
+    /** ClientName is the name the OS shows for our end of the connection */
+    virtual bool Open(const FString& ClientName, FMessageSink InSink) = 0;
+    virtual void Close() = 0;
+    virtual bool IsOpen() const = 0;
+
+protected:
+    FUmpSink UmpSink;
+};
+
+/** RtMidi API selection; Default lets RtMidi pick the compiled-in platform API */
+enum class EMidiBackendApi : uint8
+{
+    Default,
+    WindowsMM,
+    CoreMidi,
+    Alsa,
+    Jack
+};
+
+namespace MidiBackend
+{
+    /** "Default", "WindowsMM", "CoreMidi", "Alsa", "Jack" (case-insensitive); unknown -> Default */
+    UNREALMIDI_API EMidiBackendApi ParseApi(const FString& Name);
+}
+
+/** Hardware (or OS-level) MIDI input through RtMidi */
+class UNREALMIDI_API FRtMidiInputBackend : public IMidiInputBackend
+{
+public:
+    /** PortIndex from RtMidiIn enumeration */
+    explicit FRtMidiInputBackend(int32 InPortIndex, EMidiBackendApi InApi = EMidiBackendApi::Default);
+
+    /** Creates a virtual input port other applications can connect to (ALSA, JACK, CoreMIDI; not WinMM) */
+    static TUniquePtr<FRtMidiInputBackend> MakeVirtual(EMidiBackendApi InApi = EMidiBackendApi::Default);
+
+    /** Input port names for an API, in PortIndex order; false (and logged) if the API is unavailable */
+    static bool GetPortNames(EMidiBackendApi InApi, TArray<FString>& OutNames);
+
+    virtual ~FRtMidiInputBackend() override;
+
+    virtual void SetIgnoreTiming(bool bIgnore) override { bIgnoreTiming = bIgnore; }
+    virtual bool Open(const FString& ClientName, FMessageSink InSink) override;
+    virtual void Close() override;
+    virtual bool IsOpen() const override { return RtMidiInPtr != nullptr; }
+
+private:
+    int32 PortIndex = INDEX_NONE;   // INDEX_NONE = virtual port
+    EMidiBackendApi Api = EMidiBackendApi::Default;
+    bool bIgnoreTiming = false;
+
+    // Opaque RtMidiIn* stored as void* to keep header clean
+    void* RtMidiInPtr = nullptr;
+    FMessageSink Sink;
+
+    // RtMidi only reports the delta to the previous message; rebuilt absolute driver time (callback thread)
+    double DriverClock = 0.0;
+};
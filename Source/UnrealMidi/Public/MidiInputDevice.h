@@ -1,46 +1,117 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "Containers/Array.h"
+#include <atomic>
 #include "MidiTypes.h"
+#include "MidiPipelineStats.h"
+#include "MidiNoteTracker.h"
+#include "MidiMpe.h"
+#include "MidiHistory.h"
+#include "MidiClock.h"
+#include "MidiInputBackend.h"
+
+class FMidiRecordingWriter;
 
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnMidiSysExNative, const FString& /*DeviceName*/, const TArray<uint8>& /*Bytes*/);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnMidiTransportNative, const FString& /*DeviceName*/, EMidiTransport);
 
-/** Lightweight wrapper around a single RtMidiIn device */
+/** Decodes the raw messages of one input; the bytes come from an IMidiInputBackend (RtMidi by default) */
 class UNREALMIDI_API FMidiInputDevice
 {
 public:
+    /** RtMidi port with the platform default API */
     FMidiInputDevice(const FString& InDeviceName, int32 InPortIndex);
-    ~FMidiInputDevice();
 
-    bool Open();
-    void Close();
+    /** Any backend (RtMidi with a chosen API, virtual port, scripted fake) */
+    FMidiInputDevice(const FString& InDeviceName, TUniquePtr<IMidiInputBackend> InBackend);
+    virtual ~FMidiInputDevice();
+
+    virtual bool Open();
+    virtual void Close();
 
     const FString& GetName() const { return DeviceName; }
     int32 GetPortIndex() const { return PortIndex; }
+    IMidiInputBackend* GetBackend() const { return Backend.Get(); }
 
     /** Emits when this device receives a CC/Note change */
     FOnMidiValueNative& OnValue() { return OnValueDelegate; }
     FOnMidiSysExNative& OnSysEx() { return OnSysExDelegate; }
 
-private:
-    void HandleCc(int32 Chan, int32 Cc, int32 Val0to127);
-    void HandleNote(int32 Chan, int32 Note, bool bOn);
+    /** Start / Continue / Stop, on the decode thread (clock ticks themselves never leave it) */
+    FOnMidiTransportNative& OnTransport() { return OnTransportDelegate; }
+
+    /** Tap raw incoming messages into a recording (nullptr stops recording) */
+    void SetRecorder(TSharedPtr<FMidiRecordingWriter, ESPMode::ThreadSafe> InRecorder);
+
+    /** Received/decoded counters (owned by the subsystem, outlive the device); set before Open() */
+    void SetCounters(FMidiDeviceCounters* InCounters) { Counters = InCounters; }
+
+    /** Held-note sets updated on ingest (owned by the subsystem, outlive the device); set before Open() */
+    void SetNoteState(FMidiNoteState* InNotes) { Notes = InNotes; }
+
+    /** MPE member-channel traffic goes to this voice table instead of per-event values; set before Open() */
+    void SetMpeDecoder(FMidiMpeDecoder* InMpe) { Mpe = InMpe; }
+
+    /** Every CC / note value is also appended to this history slab; set before Open() */
+    void SetHistory(TSharedPtr<FMidiValueHistory, ESPMode::ThreadSafe> InHistory) { History = MoveTemp(InHistory); }
+
+    /** Clock / transport / song position messages are consumed by this tracker; set before Open() */
+    void SetClock(FMidiClockTracker* InClock) { Clock = InClock; }
+
+protected:
+    /**
+     * Decode one raw MIDI message; Now is the timestamp the pipeline sees for it.
+     * DriverSeconds is the wall-clock driver timestamp if the backend has one (0 = use arrival time).
+     */
+    void HandleMessage(double Now, const uint8* Data, int32 Size, double DriverSeconds = 0.0);
+
+    /**
+     * Decode a run of Universal MIDI Packets. MIDI 2.0 CC and note packets keep their full resolution
+     * (FMidiControlValue::RawValue) and use the same Ids as MIDI 1.0, with Group N as channels 16*N+1..;
+     * everything else is translated to MIDI 1.0 and goes through HandleMessage.
+     */
+    void HandleUmp(double Now, const uint32* Words, int32 NumWords, double DriverSeconds = 0.0);
+
+    double NowSeconds() const;
+
+    /** For synthetic devices: sleep/spin until WallTime (FPlatformTime) or until bAbort is set */
+    static void WaitUntil(double WallTime, const std::atomic<bool>& bAbort);
 
 private:
+    void BeginMessage(double DriverSeconds);
+    void HandleUmpPacket(double Now, const uint32* Words, int32 NumWords, double DriverSeconds);
+    void HandleCc(double Now, int32 Chan, int32 Cc, uint32 Raw, uint8 RawBits);
+    void HandleNote(double Now, int32 Chan, int32 Note, bool bOn, uint32 Velocity, uint8 RawBits);
+    void HandleProgramChange(double Now, int Chan, int Program);
+    void HandleSysEx(const TArray<uint8>& Bytes);
+
+protected:
     FString DeviceName;
     int32   PortIndex = -1;
 
-    // Opaque RtMidiIn* stored as void* to keep header clean
-    void* RtMidiInPtr = nullptr;
-    
-    void HandleProgramChange(int Chan, int Program);
-    double NowSeconds() const;
+private:
+    TUniquePtr<IMidiInputBackend> Backend;
+
+    // Stage stamps of the message being decoded (single decode thread per device)
+    FMidiStageTimes CurrentStages;
+
+    FMidiDeviceCounters* Counters = nullptr;
+    FMidiNoteState* Notes = nullptr;
+    FMidiMpeDecoder* Mpe = nullptr;
+    TSharedPtr<FMidiValueHistory, ESPMode::ThreadSafe> History;
+    FMidiClockTracker* Clock = nullptr;
+
+    // SysEx7 packets being reassembled (decode thread)
+    TArray<uint8> UmpSysEx;
 
     // Per-device latest values (optional; handy if you want to query per-device later)
     FCriticalSection ValuesMutex;
     TMap<FString, FMidiControlValue> LatestById;
 
+    FCriticalSection RecorderMutex;
+    TSharedPtr<FMidiRecordingWriter, ESPMode::ThreadSafe> Recorder;
+
     FOnMidiValueNative OnValueDelegate;
     FOnMidiSysExNative OnSysExDelegate;
-    void HandleSysEx(const TArray<uint8>& Bytes);
+    FOnMidiTransportNative OnTransportDelegate;
 };
@@ -0,0 +1,61 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "InputCoreTypes.h"
+#include "MidiTypes.h"
+
+class FGenericApplicationMessageHandler;
+
+/**
+ * MIDI controls as engine input keys, so Enhanced Input actions, triggers, modifiers and mapping contexts
+ * can use them like gamepad axes. CCs become 1D axis keys, notes become buttons:
+ * "IN:Launchkey:CC:1:74" -> MIDI_Launchkey_CC_1_74 (category "MIDI").
+ *
+ * A control's key is registered the first time it is seen and remembered in the config, so it is in the
+ * key pickers the next session. The subsystem queues each drained batch here; FMidiKeyInputDevice sends
+ * the frame's changes (one event per changed control) when the application polls input devices.
+ * Relative encoders and Program Change have no key.
+ */
+class UNREALMIDI_API FMidiInputKeys
+{
+public:
+    static FMidiInputKeys& Get();
+
+    static const FName MenuCategory;
+
+    /** Key name of a control Id, NAME_None for types without a key; doesn't register it */
+    static FName MakeKeyName(const FString& Id);
+
+    /** Game thread. Key of a control Id, registering (and saving) it the first time. */
+    FKey RegisterControl(const FString& Id);
+
+    /** Re-registers the controls saved by earlier sessions; module startup */
+    void RegisterSavedControls();
+
+    void SetEnabled(bool bInEnabled);
+    bool IsEnabled() const { return bEnabled; }
+
+    /** Game thread, as the subsystem dispatches a batch: latest value per control for this frame */
+    void Enqueue(const FMidiControlValue& V);
+
+    /** Game thread, once per frame */
+    void Flush(FGenericApplicationMessageHandler& Handler);
+
+private:
+    struct FControl
+    {
+        FKey  Key;
+        bool  bButton = false;
+        float Value = 0.f;      // axis: latest; button: > 0 = held
+        float SentValue = -1.f;
+        bool  bPressQueued = false; // note-on since the last flush (a tap within one frame still presses)
+        bool  bSentDown = false;
+        bool  bDirty = false;
+    };
+
+    int32 FindOrAddControl(const FString& Id, bool bSave);
+
+    bool bEnabled = true;
+    TMap<FString, int32> ControlIndex;
+    TArray<FControl> Controls;
+    TArray<int32> Dirty;
+};
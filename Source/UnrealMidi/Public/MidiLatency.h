@@ -0,0 +1,115 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "MidiTypes.h"
+#include <atomic>
+#include "MidiLatency.generated.h"
+
+// "stat UnrealMidi"; MidiMapper adds its trigger counter to the same group
+DECLARE_STATS_GROUP(TEXT("UnrealMidi"), STATGROUP_UnrealMidi, STATCAT_Advanced);
+
+// Insights channel for MIDI events: -trace=default,UnrealMidi
+UE_TRACE_CHANNEL_EXTERN(UnrealMidiChannel, UNREALMIDI_API);
+
+/**
+ * Intervals between the stamps in FMidiStageTimes. No backend hands us an absolute driver time: the RtMidi
+ * driver stamp is rebuilt from delta times and re-anchored to the callback, so the Driver* stages measure
+ * drift since the last re-anchor (0..250 ms), not driver-to-engine latency.
+ */
+UENUM(BlueprintType)
+enum class EMidiLatencyStage : uint8
+{
+    DriverToCallback UMETA(DisplayName="Driver Jitter"),   // callback lag behind the rebuilt driver clock
+    CallbackToFilter,
+    FilterToDispatch,
+    DispatchToTrigger,
+    DriverToDispatch,   // fader moved -> OnMidiValue
+    DriverToTrigger,    // fader moved -> rig function
+    Num UMETA(Hidden)
+};
+
+USTRUCT(BlueprintType)
+struct UNREALMIDI_API FMidiLatencyPercentiles
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Latency") int64 Count = 0;
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Latency") float MeanMs = 0.f;
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Latency") float P50Ms = 0.f;
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Latency") float P99Ms = 0.f;
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Latency") float P999Ms = 0.f;
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Latency") float MaxMs = 0.f;
+};
+
+/**
+ * Log-scale latency histogram: 4 buckets per power of two of nanoseconds (<= 19% bucket error),
+ * 1 ns .. ~18 min. Add() is wait-free and may be called from any thread.
+ */
+class UNREALMIDI_API FMidiLatencyHistogram
+{
+public:
+    static constexpr int32 SubBucketBits = 2;
+    static constexpr int32 NumBuckets = 40 << SubBucketBits;
+
+    void Add(double Seconds);
+    void Reset();
+
+    /** Copies the bucket counts (relaxed; concurrent adds may or may not be included) */
+    void Snapshot(uint64 (&OutCounts)[NumBuckets]) const;
+
+    FMidiLatencyPercentiles GetPercentiles() const;
+    static FMidiLatencyPercentiles ComputePercentiles(const uint64 (&Counts)[NumBuckets], uint64 SumNs, uint64 MaxNs);
+
+    static int32  BucketIndex(uint64 Ns);
+    static double BucketUpperNs(int32 Index);
+
+private:
+    std::atomic<uint64> Buckets[NumBuckets] = {};
+    std::atomic<uint64> SumNs { 0 };
+    std::atomic<uint64> MaxNs { 0 };
+};
+
+/** One histogram per stage interval */
+struct FMidiDeviceLatency
+{
+    FMidiLatencyHistogram Stages[(int32)EMidiLatencyStage::Num];
+};
+
+/**
+ * Process-wide latency registry, keyed by device. The subsystem records up to the game-thread
+ * dispatch; UMidiMappingManager records the trigger. Tick() publishes a rolling window of
+ * all devices to "stat UnrealMidi", the CSV profiler and Insights counters.
+ */
+class UNREALMIDI_API FMidiLatencyTracker
+{
+public:
+    static FMidiLatencyTracker& Get();
+
+    /** Game thread, as OnMidiValue fires; also emits the UnrealMidi.Event trace record */
+    void RecordDispatch(const FMidiControlValue& V);
+    void RecordTrigger(const FString& DeviceName, const FMidiStageTimes& T);
+
+    bool GetPercentiles(const FString& DeviceName, EMidiLatencyStage Stage, FMidiLatencyPercentiles& Out) const;
+    void GetDeviceNames(TArray<FString>& OutNames) const;
+    void Reset();
+
+    /** Game thread, once per frame */
+    void Tick(float DeltaTime);
+
+    void DumpToLog(FOutputDevice& Ar) const;
+
+private:
+    FMidiDeviceLatency& FindOrAdd(const FString& DeviceName);
+    static void Add(FMidiDeviceLatency& D, EMidiLatencyStage Stage, double From, double To);
+
+    mutable FRWLock DevicesLock;
+    TMap<FString, TUniquePtr<FMidiDeviceLatency>> Devices;
+
+    // Rolling window (all devices), published every WindowSeconds
+    static constexpr double WindowSeconds = 0.5;
+    double WindowStart = 0.0;
+    // Written by Tick (sole ticker) under the read lock; Reset takes the write lock to exclude it
+    uint64 PrevCounts[(int32)EMidiLatencyStage::Num][FMidiLatencyHistogram::NumBuckets] = {};
+    FMidiLatencyPercentiles Window[(int32)EMidiLatencyStage::Num];
+};
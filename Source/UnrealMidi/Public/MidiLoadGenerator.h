@@ -0,0 +1,88 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Math/RandomStream.h"
+#include "MidiInputDevice.h"
+#include "MidiLoadGenerator.generated.h"
+
+class FRunnableThread;
+
+UENUM(BlueprintType)
+enum class EMidiLoadWaveform : uint8
+{
+    Sweep,      // saw 0..127 over PeriodSeconds
+    Sine,
+    Noise,      // uniform random values
+    Burst,      // BurstSize back-to-back CCs once per PeriodSeconds, silent otherwise
+    NoteStorm,  // alternating note on/off
+    SysExDump   // SysExBytes-long dumps
+};
+
+USTRUCT(BlueprintType)
+struct UNREALMIDI_API FMidiLoadGenSettings
+{
+    GENERATED_BODY()
+
+    // Controls per device (CC or note numbers starting at FirstControl)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="LoadGen")
+    int32 NumControls = 64;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="LoadGen")
+    int32 FirstControl = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="LoadGen")
+    int32 Channel = 1;
+
+    // Update rate per control (Hz)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="LoadGen")
+    float RateHz = 1000.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="LoadGen")
+    EMidiLoadWaveform Waveform = EMidiLoadWaveform::Sweep;
+
+    // Optional per-control override (control number -> waveform)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="LoadGen")
+    TMap<int32, EMidiLoadWaveform> PerControlWaveform;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="LoadGen")
+    float PeriodSeconds = 2.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="LoadGen")
+    int32 BurstSize = 32;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="LoadGen")
+    int32 SysExBytes = 256;
+};
+
+/**
+ * In-process synthetic device: produces raw MIDI at a fixed rate on its own thread and feeds
+ * it through the regular decode path, so load tests exercise exactly what hardware would.
+ */
+class UNREALMIDI_API FMidiLoadGenerator : public FMidiInputDevice, public FRunnable
+{
+public:
+    FMidiLoadGenerator(const FString& InDeviceName, const FMidiLoadGenSettings& InSettings, int32 InSeed);
+    virtual ~FMidiLoadGenerator() override;
+
+    virtual bool Open() override;
+    virtual void Close() override;
+
+    /** Messages produced so far (any thread) */
+    uint64 GetNumGenerated() const { return NumGenerated.load(std::memory_order_relaxed); }
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override { bStopRequested = true; }
+
+private:
+    void EmitControl(double Now, int32 Control, int64 Step);
+    void Emit(double Now, const uint8* Data, int32 Size);
+
+    FMidiLoadGenSettings Settings;
+    FRandomStream Random;
+    TArray<uint8> SysExBuffer;
+
+    FRunnableThread* Thread = nullptr;
+    std::atomic<bool> bStopRequested { false };
+    std::atomic<uint64> NumGenerated { 0 };
+};
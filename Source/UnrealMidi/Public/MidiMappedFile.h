@@ -0,0 +1,27 @@
+#pragma once
+#include "CoreMinimal.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/** Read-only memory mapping of a whole file (shared by the recording and SMF readers) */
+class UNREALMIDI_API FMidiMappedFile
+{
+public:
+    FMidiMappedFile() = default;
+    ~FMidiMappedFile();
+
+    bool Open(const FString& FilePath);
+    void Close();
+
+    bool IsOpen() const { return Base != nullptr; }
+    const uint8* GetData() const { return Base; }
+    int64 GetSize() const { return Length; }
+
+private:
+    TUniquePtr<IMappedFileHandle> Handle;
+    TUniquePtr<IMappedFileRegion> Region;
+
+    const uint8* Base = nullptr;
+    int64 Length = 0;
+};
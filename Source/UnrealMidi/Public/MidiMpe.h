@@ -0,0 +1,92 @@
+#pragma once
+#include "CoreMinimal.h"
+#include <atomic>
+#include "MidiSeqLock.h"
+#include "MidiMpe.generated.h"
+
+struct FMidiNoteState;
+
+/** One sounding MPE note as seen by gameplay code */
+USTRUCT(BlueprintType)
+struct UNREALMIDI_API FMidiMpeVoice
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|MPE") int32 Note = 0;       // 0..127
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|MPE") int32 Channel = 0;    // member channel 1..16
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|MPE") float Velocity = 0.f; // strike, 0..1
+
+    // Note + per-note bend + zone (master channel) bend, in semitones
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|MPE") float Pitch = 0.f;
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|MPE") float Bend = 0.f;     // semitones
+
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|MPE") float Pressure = 0.f; // channel pressure, 0..1
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|MPE") float Timbre = 0.5f;  // CC74, 0..1
+};
+
+/** Sounding voices, struct-of-arrays so the per-message update touches one lane per field */
+struct FMidiMpeVoiceTable
+{
+    static constexpr int32 MaxVoices = 32;
+
+    uint32 ActiveMask = 0;
+    uint8  Note[MaxVoices] = {};
+    uint8  Channel[MaxVoices] = {};      // 1..16
+    uint8  Velocity[MaxVoices] = {};
+    uint32 Age[MaxVoices] = {};          // note-on order, for stealing the oldest voice
+    float  Bend[MaxVoices] = {};         // semitones
+    float  Pressure[MaxVoices] = {};
+    float  Timbre[MaxVoices] = {};
+    float  ZoneBend[2] = {};             // master channel bend of the lower/upper zone, semitones
+};
+
+/**
+ * MPE zone decoder for one device. Member-channel notes and their pitch bend, channel pressure /
+ * poly aftertouch and CC74 land in a fixed voice table instead of per-channel string Ids; everything
+ * else (master channel controls, non-MPE channels) keeps going through the normal decoder.
+ *
+ * Zones come from SetZones or from an MPE Configuration Message (RPN 6 on channel 1 or 16).
+ * Decode thread writes, any thread reads (seqlock).
+ */
+class UNREALMIDI_API FMidiMpeDecoder
+{
+public:
+    FMidiMpeDecoder();
+
+    /** LowerMembers: channels 2..1+N (master 1); UpperMembers: channels 15-N+1..15 (master 16); 0/0 = off */
+    void SetZones(int32 LowerMembers, int32 UpperMembers);
+    void GetZones(int32& OutLowerMembers, int32& OutUpperMembers) const;
+    bool IsEnabled() const { return ZoneBits.load(std::memory_order_relaxed) != 0; }
+
+    /**
+     * Decode thread. Returns true if the message belonged to an MPE member channel and was consumed.
+     * Notes, if set, mirrors voice on/off into the held-note tracker.
+     */
+    bool HandleMessage(const uint8* Data, int32 Size, FMidiNoteState* Notes);
+
+    /** Forget all voices and per-channel expression (device (re)opened or closed) */
+    void Reset();
+
+    /** Any thread */
+    void GetVoices(TArray<FMidiMpeVoice>& OutVoices) const;
+    uint32 GetVersion() const { return Voices.GetVersion(); }
+
+private:
+    // Zone lookups packed into one word: bits 0..15 lower members, 16..31 upper members (bit = channel-1)
+    int32 ZoneOf(int32 Chan) const;
+    void  TrackRpn(int32 Chan, int32 Cc, int32 Val);
+
+    std::atomic<uint32> ZoneBits { 0 };
+
+    // Decode thread only
+    struct FChannelState
+    {
+        float Bend = 0.f, Pressure = 0.f, Timbre = 0.5f;
+        float BendRange = 48.f;     // semitones; MPE default 48 for members, 2 for masters
+        int32 RpnMsb = 127, RpnLsb = 127;
+    };
+    FChannelState Channels[16];
+    uint32 NextAge = 0;
+
+    TMidiSeqLock<FMidiMpeVoiceTable> Voices;
+};
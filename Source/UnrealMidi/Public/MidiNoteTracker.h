@@ -0,0 +1,99 @@
+#pragma once
+#include "CoreMinimal.h"
+#include <atomic>
+
+/** 128 notes as two words; bit N = note N */
+struct FMidiNoteMask
+{
+    uint64 Lo = 0;   // notes 0..63
+    uint64 Hi = 0;   // notes 64..127
+
+    bool IsEmpty() const { return (Lo | Hi) == 0; }
+    bool Contains(int32 Note) const { return ((Note < 64 ? Lo >> Note : Hi >> (Note - 64)) & 1) != 0; }
+    int32 Num() const { return int32(FMath::CountBits(Lo) + FMath::CountBits(Hi)); }
+
+    /** Lowest set note, INDEX_NONE if empty */
+    int32 Lowest() const
+    {
+        if (Lo) return int32(FMath::CountTrailingZeros64(Lo));
+        if (Hi) return 64 + int32(FMath::CountTrailingZeros64(Hi));
+        return INDEX_NONE;
+    }
+
+    /** Shifted up by Semitones (bits past 127 fall off) */
+    FMidiNoteMask operator<<(int32 Semitones) const
+    {
+        FMidiNoteMask R;
+        if (Semitones <= 0)        { R = *this; }
+        else if (Semitones >= 128) { }
+        else if (Semitones >= 64)  { R.Hi = Lo << (Semitones - 64); }
+        else                       { R.Lo = Lo << Semitones; R.Hi = (Hi << Semitones) | (Lo >> (64 - Semitones)); }
+        return R;
+    }
+
+    FMidiNoteMask operator|(const FMidiNoteMask& O) const { return { Lo | O.Lo, Hi | O.Hi }; }
+    FMidiNoteMask operator&(const FMidiNoteMask& O) const { return { Lo & O.Lo, Hi & O.Hi }; }
+    bool operator==(const FMidiNoteMask& O) const { return Lo == O.Lo && Hi == O.Hi; }
+
+    /** Folded to 12 pitch classes; bit 0 = C */
+    uint16 PitchClasses() const;
+
+    /** Mask of Intervals (semitones, may exceed an octave) above note 0 */
+    static FMidiNoteMask FromIntervals(TConstArrayView<int32> Intervals);
+};
+
+/**
+ * Held notes of one device: one 128-bit set per channel. Written by the device's decode thread with
+ * atomic or/and, read from any thread without locking (a query sees each word at some recent point).
+ * Channels are 1..16; queries take 0 to mean all channels combined.
+ */
+struct UNREALMIDI_API FMidiNoteState
+{
+    void NoteOn(int32 Chan, int32 Note)  { Word(Chan, Note).fetch_or(Bit(Note), std::memory_order_relaxed); }
+    void NoteOff(int32 Chan, int32 Note) { Word(Chan, Note).fetch_and(~Bit(Note), std::memory_order_relaxed); }
+
+    /** CC 120 (all sound off) / CC 123 (all notes off) */
+    void AllNotesOff(int32 Chan)
+    {
+        Held[Chan - 1][0].store(0, std::memory_order_relaxed);
+        Held[Chan - 1][1].store(0, std::memory_order_relaxed);
+    }
+
+    /** Device opened, closed or unplugged: nothing is held any more */
+    void Reset()
+    {
+        for (int32 Chan = 1; Chan <= 16; ++Chan)
+            AllNotesOff(Chan);
+    }
+
+    FMidiNoteMask GetMask(int32 Chan) const;
+
+    bool IsNoteHeld(int32 Chan, int32 Note) const
+    {
+        if (Note < 0 || Note > 127) return false;
+        if (Chan >= 1 && Chan <= 16)
+            return (Held[Chan - 1][Note >> 6].load(std::memory_order_relaxed) & Bit(Note)) != 0;
+        return GetMask(Chan).Contains(Note);
+    }
+
+    int32 NumHeld(int32 Chan) const { return GetMask(Chan).Num(); }
+
+    /** Held notes in ascending order; returns how many */
+    int32 GetHeldNotes(int32 Chan, TArray<int32>& OutNotes) const;
+
+    /**
+     * Chord in any octave or inversion: Intervals above the root (e.g. 0,4,7 = major triad), compared as
+     * pitch classes. bExact also rejects extra pitch classes. Returns the root pitch class (0 = C) or INDEX_NONE;
+     * the lowest held note's pitch class is tried first, so inversions report their written root.
+     */
+    int32 MatchChord(int32 Chan, TConstArrayView<int32> Intervals, bool bExact) const;
+
+    /** Exact voicing: the held notes are exactly Intervals stacked on the lowest held note */
+    bool MatchVoicing(int32 Chan, TConstArrayView<int32> Intervals) const;
+
+private:
+    static uint64 Bit(int32 Note) { return uint64(1) << (Note & 63); }
+    std::atomic<uint64>& Word(int32 Chan, int32 Note) { return Held[Chan - 1][Note >> 6]; }
+
+    std::atomic<uint64> Held[16][2] = {};
+};
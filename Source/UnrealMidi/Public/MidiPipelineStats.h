@@ -0,0 +1,94 @@
+#pragma once
+#include "CoreMinimal.h"
+#include <atomic>
+#include "MidiPipelineStats.generated.h"
+
+/** Snapshot of one device's pipeline counters (totals since start/reset) */
+USTRUCT(BlueprintType)
+struct UNREALMIDI_API FMidiPipelineCounters
+{
+    GENERATED_BODY()
+
+    // Raw messages delivered by the backend
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Health") int64 Received = 0;
+
+    // CC / Note / PC values (and SysEx dumps) produced by the decoder
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Health") int64 Decoded = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Health") int64 FilterPassed = 0;
+
+    // Dropped by the Schmitt filter (below threshold / debounce)
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Health") int64 FilterRejected = 0;
+
+    // Dropped by SuppressOthersAfterDigital
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Health") int64 SuppressionDropped = 0;
+
+    // Superseded by a newer value of the same CC before the game thread picked it up
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Health") int64 Coalesced = 0;
+
+    // Broadcast through OnMidiValue
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Health") int64 Dispatched = 0;
+
+    // Dropped because the dispatch queue was full (game thread not keeping up)
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Health") int64 Overflowed = 0;
+
+    // Rolling rates over the last second
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Health") float ReceivedPerSecond = 0.f;
+    UPROPERTY(BlueprintReadOnly, Category="UnrealMidi|Health") float DispatchedPerSecond = 0.f;
+};
+
+/** Live counters of one device. Increments are relaxed atomics, cheap enough to stay always on. */
+struct UNREALMIDI_API FMidiDeviceCounters
+{
+    std::atomic<uint64> Received { 0 };
+    std::atomic<uint64> Decoded { 0 };
+    std::atomic<uint64> FilterPassed { 0 };
+    std::atomic<uint64> FilterRejected { 0 };
+    std::atomic<uint64> SuppressionDropped { 0 };
+    std::atomic<uint64> Coalesced { 0 };
+    std::atomic<uint64> Dispatched { 0 };
+    std::atomic<uint64> Overflowed { 0 };
+
+    // Rates, maintained by the subsystem on the game thread
+    uint64 PrevReceived = 0;
+    uint64 PrevDispatched = 0;
+    float  ReceivedPerSecond = 0.f;
+    float  DispatchedPerSecond = 0.f;
+
+    static void Bump(std::atomic<uint64>& Counter) { Counter.fetch_add(1, std::memory_order_relaxed); }
+
+    void UpdateRates(double Elapsed)
+    {
+        const uint64 R = Received.load(std::memory_order_relaxed);
+        const uint64 D = Dispatched.load(std::memory_order_relaxed);
+        ReceivedPerSecond   = float((R - PrevReceived) / Elapsed);
+        DispatchedPerSecond = float((D - PrevDispatched) / Elapsed);
+        PrevReceived = R;
+        PrevDispatched = D;
+    }
+
+    FMidiPipelineCounters Snapshot() const
+    {
+        FMidiPipelineCounters S;
+        S.Received           = (int64)Received.load(std::memory_order_relaxed);
+        S.Decoded            = (int64)Decoded.load(std::memory_order_relaxed);
+        S.FilterPassed       = (int64)FilterPassed.load(std::memory_order_relaxed);
+        S.FilterRejected     = (int64)FilterRejected.load(std::memory_order_relaxed);
+        S.SuppressionDropped = (int64)SuppressionDropped.load(std::memory_order_relaxed);
+        S.Coalesced          = (int64)Coalesced.load(std::memory_order_relaxed);
+        S.Dispatched         = (int64)Dispatched.load(std::memory_order_relaxed);
+        S.Overflowed         = (int64)Overflowed.load(std::memory_order_relaxed);
+        S.ReceivedPerSecond   = ReceivedPerSecond;
+        S.DispatchedPerSecond = DispatchedPerSecond;
+        return S;
+    }
+
+    void Reset()
+    {
+        for (std::atomic<uint64>* C : { &Received, &Decoded, &FilterPassed, &FilterRejected,
+                                        &SuppressionDropped, &Coalesced, &Dispatched, &Overflowed })
+            C->store(0, std::memory_order_relaxed);
+        PrevReceived = PrevDispatched = 0;
+        ReceivedPerSecond = DispatchedPerSecond = 0.f;
+    }
+};
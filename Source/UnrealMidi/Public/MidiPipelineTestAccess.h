@@ -0,0 +1,43 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "UnrealMidiSubsystem.h"
+
+#if !UE_BUILD_SHIPPING
+
+class FMidiInputDevice;
+
+/**
+ * Test-only seam into the subsystem's pipeline stages, so MidiBench can time them one by one. Development
+ * builds only; game thread. Runtime code goes through the public API.
+ */
+struct FMidiPipelineTestAccess
+{
+    static void BindInputDevice(UUnrealMidiSubsystem& Midi, const TSharedPtr<FMidiInputDevice>& Dev)
+    {
+        Midi.BindInputDevice(Dev);
+    }
+
+    static FMidiDeviceCounters& FindOrAddCounters(UUnrealMidiSubsystem& Midi, const FString& DeviceName)
+    {
+        return Midi.FindOrAddCounters(DeviceName);
+    }
+
+    /** Suppression + Schmitt filter alone; true = the value would be forwarded */
+    static bool Filter(UUnrealMidiSubsystem& Midi, const FString& DeviceName, FMidiControlValue& V, FMidiDeviceCounters& Counters)
+    {
+        return Midi.FilterDeviceValue(DeviceName, V, Counters);
+    }
+
+    /** Queues V for the game-thread broadcast (with coalescing), as an accepted value would be */
+    static void Dispatch(UUnrealMidiSubsystem& Midi, const FMidiControlValue& V, FMidiDeviceCounters& Counters)
+    {
+        Midi.DispatchValue(V, Counters);
+    }
+
+    static void ResetControlState(UUnrealMidiSubsystem& Midi, const FString& DeviceName)
+    {
+        Midi.ResetControlState(DeviceName);
+    }
+};
+
+#endif // !UE_BUILD_SHIPPING
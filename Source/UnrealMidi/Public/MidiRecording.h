@@ -0,0 +1,84 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "MidiMappedFile.h"
+
+// Raw MIDI capture format (.umidirec), little-endian, one device per file:
+//   Header : uint32 Magic 'UMRC' | uint16 Version | uint16 NameLen | UTF-8 device name
+//   Record : double TimeSeconds (since recording start) | uint16 Size | uint8 Bytes[Size]
+namespace MidiRecording
+{
+    inline constexpr uint32 Magic   = 0x43524D55; // "UMRC"
+    inline constexpr uint16 Version = 1;
+    inline constexpr const TCHAR* Extension = TEXT("umidirec");
+}
+
+/** Collects raw messages from the input thread; written to disk on Finish() */
+class UNREALMIDI_API FMidiRecordingWriter
+{
+public:
+    FMidiRecordingWriter(const FString& InDeviceName, const FString& InFilePath);
+
+    /** Thread-safe; Now is in the same clock as the pipeline timestamps */
+    void Append(double Now, const uint8* Data, int32 Size);
+
+    /** Flushes everything captured so far; returns false if the file could not be written */
+    bool Finish();
+
+    const FString& GetFilePath() const { return FilePath; }
+    int32 GetNumRecords() const;
+
+private:
+    FString DeviceName;
+    FString FilePath;
+    double  StartTime = -1.0;
+
+    mutable FCriticalSection Mutex;
+    TArray<uint8> Buffer;
+    int32 NumRecords = 0;
+};
+
+/** One decoded message; Data stays valid until the next call to Next() */
+struct FMidiRecordedMessage
+{
+    double       TimeSeconds = 0.0;
+    const uint8* Data = nullptr;
+    int32        Size = 0;
+};
+
+/** Anything FMidiReplayDevice can play: raw recordings, Standard MIDI Files */
+class UNREALMIDI_API IMidiReplaySource
+{
+public:
+    virtual ~IMidiReplaySource() = default;
+
+    virtual const FString& GetDeviceName() const = 0;
+
+    /** Position so the next message is the first one at or after Seconds */
+    virtual bool Seek(double Seconds) = 0;
+
+    /** Returns false at end of stream */
+    virtual bool Next(FMidiRecordedMessage& Out) = 0;
+};
+
+/** Zero-copy reader over a memory-mapped recording */
+class UNREALMIDI_API FMidiRecordingReader : public IMidiReplaySource
+{
+public:
+    bool Open(const FString& FilePath);
+    void Close();
+
+    bool IsOpen() const { return File.IsOpen(); }
+
+    // IMidiReplaySource
+    virtual const FString& GetDeviceName() const override { return DeviceName; }
+    virtual bool Seek(double Seconds) override;
+    virtual bool Next(FMidiRecordedMessage& Out) override;
+
+private:
+    FMidiMappedFile File;
+
+    int64 FirstRecord = 0;
+    int64 Cursor = 0;
+
+    FString DeviceName;
+};
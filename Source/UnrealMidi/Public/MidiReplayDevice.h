@@ -0,0 +1,46 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "MidiInputDevice.h"
+#include "MidiRecording.h"
+
+class FRunnableThread;
+
+/**
+ * Plays a recorded stream (.umidirec capture or Standard MIDI File) back through the same
+ * decode path as a live RtMidi device. Events carry the recorded timeline (not wall time)
+ * so filter decisions are identical at any playback speed. Speed <= 0 replays as fast as possible.
+ */
+class UNREALMIDI_API FMidiReplayDevice : public FMidiInputDevice, public FRunnable
+{
+public:
+    /** AsDevice overrides the device name events are reported under (defaults to the recorded one) */
+    FMidiReplayDevice(const FString& InFilePath, float InSpeed, bool bInLoop,
+                      double InStartSeconds = 0.0, const FString& AsDevice = FString());
+    virtual ~FMidiReplayDevice() override;
+
+    /** Maps the file and resolves the device name; call before binding delegates */
+    bool Load();
+
+    virtual bool Open() override;
+    virtual void Close() override;
+
+    bool IsFinished() const { return bFinished; }
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override { bStopRequested = true; }
+
+private:
+    FString FilePath;
+    FString DeviceOverride;
+    float   Speed = 1.f;
+    bool    bLoop = false;
+    double  StartSeconds = 0.0;
+
+    TUniquePtr<IMidiReplaySource> Source;
+    FRunnableThread* Thread = nullptr;
+
+    std::atomic<bool> bStopRequested { false };
+    std::atomic<bool> bFinished { false };
+};
@@ -0,0 +1,58 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "MidiInputBackend.h"
+
+/**
+ * Fake backend for running the pipeline without hardware (automation, headless build agents).
+ * Nothing happens on its own: messages are delivered synchronously on the calling thread, either
+ * directly (Inject) or from a script up to a given time (Pump), so results are deterministic.
+ *
+ * Script text: one message per line, "<seconds> <hex bytes>", '#' starts a comment, e.g.
+ *     0.000  B0 07 64     # CC 7 = 100 on channel 1
+ *     0.050  90 3C 7F     # note on C4
+ * Lines of 8-digit hex words are Universal MIDI Packets (MIDI 2.0):
+ *     0.100  40B00700 80000000    # CC 7 = 0x80000000 (32-bit) on group 0, channel 1
+ */
+class UNREALMIDI_API FMidiScriptedBackend : public IMidiInputBackend
+{
+public:
+    struct FScriptedMessage
+    {
+        double TimeSeconds = 0.0;
+        TArray<uint8> Bytes;
+        TArray<uint32> Words;   // UMP instead of bytes
+    };
+
+    FMidiScriptedBackend() = default;
+    explicit FMidiScriptedBackend(TArray<FScriptedMessage> InScript);
+
+    /** Parses script text (see class comment); returns false and logs the first bad line */
+    bool LoadScript(const FString& Text);
+    bool LoadScriptFile(const FString& Path);
+    void AddMessage(double TimeSeconds, TArrayView<const uint8> Bytes);
+    void AddPackets(double TimeSeconds, TArrayView<const uint32> Words);
+
+    virtual bool Open(const FString& ClientName, FMessageSink InSink) override;
+    virtual void Close() override;
+    virtual bool IsOpen() const override { return bOpen; }
+
+    /** Deliver one message now (Now = timestamp the pipeline sees) */
+    void Inject(TArrayView<const uint8> Bytes, double Now);
+    void InjectUmp(TArrayView<const uint32> Words, double Now);
+
+    /** Deliver all scripted messages with TimeSeconds <= UpToSeconds; returns how many */
+    int32 Pump(double UpToSeconds);
+
+    /** Deliver the rest of the script */
+    int32 PumpAll() { return Pump(TNumericLimits<double>::Max()); }
+
+    bool IsFinished() const { return NextIndex >= Script.Num(); }
+    void Rewind() { NextIndex = 0; }
+
+private:
+    TArray<FScriptedMessage> Script;    // sorted by time
+    int32 NextIndex = 0;
+
+    FMessageSink Sink;
+    bool bOpen = false;
+};
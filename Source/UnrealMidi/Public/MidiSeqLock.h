@@ -0,0 +1,56 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/PlatformProcess.h"
+#include <atomic>
+#include <type_traits>
+
+/**
+ * Single-writer sequence lock around a trivially copyable block. The writer never waits; readers copy
+ * the whole block and retry if a write overlapped. Meant for small tables written on a device thread
+ * and sampled once per frame.
+ */
+template <typename T>
+class TMidiSeqLock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "TMidiSeqLock needs a trivially copyable payload");
+
+public:
+    /** Writer thread only. Fn(T&) edits the payload in place. */
+    template <typename FuncType>
+    void Write(FuncType&& Fn)
+    {
+        Seq.store(Seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        Fn(Data);
+        Seq.store(Seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /** Any thread; consistent copy of the last completed write */
+    T Read() const
+    {
+        T Copy;
+        for (;;)
+        {
+            const uint32 Before = Seq.load(std::memory_order_acquire);
+            if (Before & 1)
+            {
+                FPlatformProcess::YieldThread();
+                continue;
+            }
+            FMemory::Memcpy(&Copy, &Data, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (Seq.load(std::memory_order_relaxed) == Before)
+                return Copy;
+        }
+    }
+
+    /** Changes with every completed write; cheap "anything new?" check for pollers */
+    uint32 GetVersion() const { return Seq.load(std::memory_order_acquire) & ~1u; }
+
+    /** Writer thread only: direct access between writes */
+    const T& GetWriterView() const { return Data; }
+
+private:
+    std::atomic<uint32> Seq { 0 };
+    T Data {};
+};
@@ -22,6 +22,16 @@ struct UNREALMIDI_API FUnrealMidiDeviceInfo
     UPROPERTY(EditAnywhere, BlueprintReadWrite) int32 Index = 0; // -1 if missing
 };
 
+/** Wall-clock stamps (FPlatformTime::Seconds) of one event through the pipeline; 0 = stage not reached */
+struct FMidiStageTimes
+{
+    double Driver   = 0.0; // rebuilt from RtMidi's delta times, re-anchored to Callback; = Callback for synthetic devices
+    double Callback = 0.0; // device callback entered the decoder
+    double Filter   = 0.0; // filter/suppression decision made
+    double Dispatch = 0.0; // game-thread broadcast started
+    double Trigger  = 0.0; // mapped function invoked (UMidiMappingManager::TriggerFunction)
+};
+
 USTRUCT(BlueprintType)
 struct UNREALMIDI_API FMidiControlValue
 {
@@ -34,6 +44,18 @@ struct UNREALMIDI_API FMidiControlValue
     UPROPERTY(EditAnywhere, BlueprintReadOnly) FString Device;
     UPROPERTY(EditAnywhere, BlueprintReadOnly) int32 ControlId = -1;
     UPROPERTY(EditAnywhere, BlueprintReadOnly) int32 Channel = -1;
+
+    // Value as received, before normalizing: 7-bit for MIDI 1.0, 32-bit CC / 16-bit velocity for MIDI 2.0
+    UPROPERTY(EditAnywhere, BlueprintReadOnly) int64 RawValue = 0;
+    UPROPERTY(EditAnywhere, BlueprintReadOnly) uint8 RawBits = 7;
+
+    // Relative (endless encoder) CC: RawValue is an encoded tick count, not a position
+    UPROPERTY(EditAnywhere, BlueprintReadOnly) bool bRelative = false;
+
+    // Note on/off: Type stays CC, Value is 0/1 and RawValue the velocity (Id has :NOTE:)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly) bool bNote = false;
+
+    FMidiStageTimes Stages; // latency instrumentation, native only
 };
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnMidiValueNative, const FMidiControlValue&);
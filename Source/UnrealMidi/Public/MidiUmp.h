@@ -0,0 +1,48 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * Universal MIDI Packet (MIDI 2.0) helpers. Packets are 1..4 host-order 32-bit words; the message
+ * type in the top nibble of the first word gives the length. Translation to and from MIDI 1.0 uses
+ * the spec's min-center-max scaling, so 7-bit values round-trip exactly.
+ */
+namespace MidiUmp
+{
+    enum class EMessageType : uint8
+    {
+        Utility        = 0x0,
+        System         = 0x1,   // real-time / common
+        Midi1Voice     = 0x2,   // MIDI 1.0 channel voice, 7-bit data
+        Data64         = 0x3,   // SysEx7
+        Midi2Voice     = 0x4,   // MIDI 2.0 channel voice, 16/32-bit data
+        Data128        = 0x5,
+        FlexData       = 0xD,
+        Stream         = 0xF
+    };
+
+    inline EMessageType GetType(uint32 Word0) { return EMessageType(Word0 >> 28); }
+    inline uint8 GetGroup(uint32 Word0)       { return uint8((Word0 >> 24) & 0x0F); }
+    inline uint8 GetStatus(uint32 Word0)      { return uint8((Word0 >> 16) & 0xF0); }   // 0x80..0xE0 for voice messages
+    inline uint8 GetChannel(uint32 Word0)     { return uint8((Word0 >> 16) & 0x0F); }   // 0..15
+    inline uint8 GetByte2(uint32 Word0)       { return uint8((Word0 >> 8) & 0xFF); }    // note / controller index
+    inline uint8 GetByte3(uint32 Word0)       { return uint8(Word0 & 0xFF); }
+
+    /** Words in the packet starting with Word0 (1, 2, 3 or 4) */
+    UNREALMIDI_API int32 GetWordCount(uint32 Word0);
+
+    /** Min-center-max upscale (e.g. 7 -> 32 bits): 0 -> 0, center -> center, max -> max */
+    UNREALMIDI_API uint32 Upscale(uint32 Value, int32 SrcBits, int32 DstBits);
+    inline uint32 Downscale(uint32 Value, int32 SrcBits, int32 DstBits) { return Value >> (SrcBits - DstBits); }
+
+    /**
+     * MIDI 1.0 channel voice bytes -> MIDI 2.0 channel voice packet (2 words). Returns words written,
+     * 0 for anything that is not a channel voice message.
+     */
+    UNREALMIDI_API int32 FromMidi1(const uint8* Data, int32 Size, uint8 Group, uint32 OutWords[2]);
+
+    /**
+     * MIDI 1.0 / MIDI 2.0 channel voice or system packet -> MIDI 1.0 bytes. Returns bytes written (max 3),
+     * 0 if the packet has no MIDI 1.0 equivalent (per-note controllers, RPN/NRPN as one message, ...).
+     */
+    UNREALMIDI_API int32 ToMidi1(const uint32* Words, int32 NumWords, uint8 OutBytes[3]);
+}
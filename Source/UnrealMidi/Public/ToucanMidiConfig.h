@@ -9,6 +9,9 @@ namespace ToucanCfg
 	inline constexpr const TCHAR* Section      = TEXT("ToucanMidiController");
 	inline constexpr const TCHAR* Key          = TEXT("SelectedDevices");  // "IN|Name" / "OUT|Name"
 	inline constexpr const TCHAR* ThresholdKey = TEXT("NoiseThreshold");   // optional legacy/global
+	inline constexpr const TCHAR* BackendKey   = TEXT("Backend");          // RtMidi API: Default/WindowsMM/CoreMidi/Alsa/Jack
+	inline constexpr const TCHAR* InputKeysKey        = TEXT("InputKeyControls"); // control Ids registered as FKeys
+	inline constexpr const TCHAR* InputKeysEnabledKey = TEXT("bInputKeys");
 	// Helper to build per-device section names
 	inline FString DeviceSection(const FString& Dev)
 	{
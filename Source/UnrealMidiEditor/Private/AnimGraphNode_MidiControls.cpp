@@ -0,0 +1,28 @@
+#include "AnimGraphNode_MidiControls.h"
+
+#define LOCTEXT_NAMESPACE "AnimGraphNode_MidiControls"
+
+FText UAnimGraphNode_MidiControls::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+    if (TitleType == ENodeTitleType::ListView || TitleType == ENodeTitleType::MenuTitle || Node.Bindings.Num() == 0)
+        return LOCTEXT("Title", "MIDI Controls");
+
+    return FText::Format(LOCTEXT("TitleWithCount", "MIDI Controls ({0})"), Node.Bindings.Num());
+}
+
+FText UAnimGraphNode_MidiControls::GetTooltipText() const
+{
+    return LOCTEXT("Tooltip", "Drives curves and bones from MIDI controls, read on the animation worker thread.");
+}
+
+FString UAnimGraphNode_MidiControls::GetNodeCategory() const
+{
+    return TEXT("MIDI");
+}
+
+FLinearColor UAnimGraphNode_MidiControls::GetNodeTitleColor() const
+{
+    return FLinearColor(0.2f, 0.6f, 0.9f);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,21 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "AnimGraphNode_Base.h"
+#include "AnimNode_MidiControls.h"
+#include "AnimGraphNode_MidiControls.generated.h"
+
+/** Anim graph editor node for FAnimNode_MidiControls */
+UCLASS()
+class UAnimGraphNode_MidiControls : public UAnimGraphNode_Base
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(EditAnywhere, Category="Settings")
+    FAnimNode_MidiControls Node;
+
+    virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+    virtual FText GetTooltipText() const override;
+    virtual FString GetNodeCategory() const override;
+    virtual FLinearColor GetNodeTitleColor() const override;
+};
@@ -120,6 +120,38 @@ TSharedRef<ITableRow> SToucanMidiPicker::OnGenerateRow(FToucanDeviceRowPtr Item,
                         .HighlightText(FText::GetEmpty())
                 ]
 
+            // Live pipeline counters (inputs only)
+            + SHorizontalBox::Slot()
+                .AutoWidth()
+                .VAlign(VAlign_Center)
+                .Padding(8, 0, 0, 0)
+                [
+                    SNew(STextBlock)
+                        .Visibility(Item->bIsInput ? EVisibility::Visible : EVisibility::Collapsed)
+                        .ToolTipText(LOCTEXT("HealthTip",
+                            "Received events/s | passed filter, rejected by filter, dropped by digital suppression, "
+                            "coalesced before dispatch, dropped because the game thread fell behind"))
+                        .Text_Lambda([Item]()
+                            {
+                                FMidiPipelineCounters C;
+                                UUnrealMidiSubsystem* Sys = GEngine ? GEngine->GetEngineSubsystem<UUnrealMidiSubsystem>() : nullptr;
+                                if (!Sys || !Sys->GetPipelineCounters(Item->Name, C))
+                                    return FText::GetEmpty();
+
+                                return FText::FromString(FString::Printf(
+                                    TEXT("%.0f ev/s | pass %lld  rej %lld  supp %lld  coal %lld  ovf %lld"),
+                                    C.ReceivedPerSecond, C.FilterPassed, C.FilterRejected,
+                                    C.SuppressionDropped, C.Coalesced, C.Overflowed));
+                            })
+                        .ColorAndOpacity_Lambda([Item]()
+                            {
+                                FMidiPipelineCounters C;
+                                UUnrealMidiSubsystem* Sys = GEngine ? GEngine->GetEngineSubsystem<UUnrealMidiSubsystem>() : nullptr;
+                                const bool bLosing = Sys && Sys->GetPipelineCounters(Item->Name, C) && C.Overflowed > 0;
+                                return bLosing ? FSlateColor(FLinearColor::Red) : FSlateColor::UseSubduedForeground();
+                            })
+                ]
+
             // Gear button → per-device filter settings
             + SHorizontalBox::Slot()
                 .AutoWidth()
@@ -12,6 +12,7 @@ public class UnrealMidiEditor : ModuleRules
             "ToolMenus", "Projects",
             "UnrealMidi", // depend on runtime module
             "InputCore",
+            "AnimGraph", "BlueprintGraph", // UAnimGraphNode_MidiControls
         });
     }
 }
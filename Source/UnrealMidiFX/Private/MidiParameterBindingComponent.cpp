@@ -0,0 +1,107 @@
+#include "MidiParameterBindingComponent.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+#include "NiagaraComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "UnrealMidiSubsystem.h"
+
+UMidiParameterBindingComponent::UMidiParameterBindingComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    bTickInEditor = true;   // knobs preview in the level editor too
+}
+
+void UMidiParameterBindingComponent::OnRegister()
+{
+    Super::OnRegister();
+    RefreshBindings();
+}
+
+#if WITH_EDITOR
+void UMidiParameterBindingComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    RefreshBindings();
+}
+#endif
+
+void UMidiParameterBindingComponent::RefreshBindings()
+{
+    Resolved.Reset();
+    Resolved.SetNum(Bindings.Num());
+    Collections.Reset();
+
+    UUnrealMidiSubsystem* Midi = GEngine ? GEngine->GetEngineSubsystem<UUnrealMidiSubsystem>() : nullptr;
+    UWorld* World = GetWorld();
+
+    ResolvedNiagara = Niagara;
+    if (!ResolvedNiagara && GetOwner())
+        ResolvedNiagara = GetOwner()->FindComponentByClass<UNiagaraComponent>();
+
+    for (int32 i = 0; i < Bindings.Num(); ++i)
+    {
+        const FMidiParameterBinding& B = Bindings[i];
+        FResolved& R = Resolved[i];
+
+        if (Midi)
+            R.Handle = Midi->ResolveControl(B.ControlId);
+
+        if (B.Parameter.IsNone())
+            continue;
+
+        if (B.Target == EMidiParameterTarget::MaterialCollection)
+        {
+            if (B.Collection && World)
+            {
+                if (UMaterialParameterCollectionInstance* Instance = World->GetParameterCollectionInstance(B.Collection))
+                    R.Collection = Collections.AddUnique(Instance);
+            }
+        }
+        else
+        {
+            const FString Name = B.Parameter.ToString();
+            R.NiagaraName = Name.StartsWith(TEXT("User.")) ? B.Parameter : FName(*(TEXT("User.") + Name));
+        }
+    }
+}
+
+void UMidiParameterBindingComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    FNiagaraUserRedirectionParameterStore* NiagaraStore = ResolvedNiagara ? &ResolvedNiagara->GetOverrideParameters() : nullptr;
+    bool bNiagaraChanged = false;
+
+    for (int32 i = 0; i < Resolved.Num() && i < Bindings.Num(); ++i)
+    {
+        FResolved& R = Resolved[i];
+        float Raw;
+        if (!R.Handle.Read(Raw))
+            continue;
+
+        const FMidiParameterBinding& B = Bindings[i];
+        const FRichCurve* Shape = B.Curve.GetRichCurveConst();
+        const float Shaped = Shape && Shape->GetNumKeys() > 0 ? Shape->Eval(Raw) : Raw;
+        const float Value = FMath::Lerp(B.OutputMin, B.OutputMax, Shaped);
+        if (Value == R.Applied)
+            continue;
+        R.Applied = Value;
+
+        if (R.Collection != INDEX_NONE)
+        {
+            // Marks the instance dirty; the world sends all dirty collections to the renderer once per frame
+            if (UMaterialParameterCollectionInstance* Instance = Collections[R.Collection].Get())
+                Instance->SetScalarParameterValue(B.Parameter, Value);
+        }
+        else if (NiagaraStore && !R.NiagaraName.IsNone())
+        {
+            NiagaraStore->SetParameterValue(Value, FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), R.NiagaraName));
+            bNiagaraChanged = true;
+        }
+    }
+
+    if (bNiagaraChanged)
+        NiagaraStore->Tick();
+}
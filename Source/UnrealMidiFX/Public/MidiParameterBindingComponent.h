@@ -0,0 +1,97 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Curves/CurveFloat.h"
+#include "MidiControlStore.h"
+#include "MidiParameterBindingComponent.generated.h"
+
+class UMaterialParameterCollection;
+class UMaterialParameterCollectionInstance;
+class UNiagaraComponent;
+
+UENUM(BlueprintType)
+enum class EMidiParameterTarget : uint8
+{
+    MaterialCollection,     // scalar parameter of a Material Parameter Collection
+    NiagaraUser             // float user parameter of the component's Niagara system
+};
+
+USTRUCT(BlueprintType)
+struct UNREALMIDIFX_API FMidiParameterBinding
+{
+    GENERATED_BODY()
+
+    /** "IN:Device:CC:1:74" / "IN:Device:NOTE:10:36" */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI")
+    FString ControlId;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI")
+    EMidiParameterTarget Target = EMidiParameterTarget::MaterialCollection;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI", meta=(EditCondition="Target==EMidiParameterTarget::MaterialCollection", EditConditionHides))
+    TObjectPtr<UMaterialParameterCollection> Collection;
+
+    /** MPC scalar name, or the Niagara user parameter with or without "User." */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI")
+    FName Parameter;
+
+    /** Optional shaping of the control's 0..1 before the output range (no keys = linear) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI")
+    FRuntimeFloatCurve Curve;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI")
+    float OutputMin = 0.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI")
+    float OutputMax = 1.f;
+};
+
+/**
+ * Declarative knob -> material / VFX parameter bindings. Once per frame it reads every bound control's
+ * latest value (lock-free, see FMidiControlHandle), skips the unchanged ones and applies the rest in one
+ * pass: the MPC instances are updated together (the engine pushes them to the render thread once, at the
+ * end of the frame) and the Niagara user parameters are written straight into the override store.
+ * Replaces one Blueprint SetScalarParameterValue per MIDI event.
+ */
+UCLASS(ClassGroup=(MIDI), meta=(BlueprintSpawnableComponent))
+class UNREALMIDIFX_API UMidiParameterBindingComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UMidiParameterBindingComponent();
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="MIDI")
+    TArray<FMidiParameterBinding> Bindings;
+
+    /** Niagara user parameters go here; the owner's first Niagara component if unset (read by RefreshBindings) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="MIDI")
+    TObjectPtr<UNiagaraComponent> Niagara;
+
+    /** Re-resolves controls and targets; call after changing Bindings at runtime */
+    UFUNCTION(BlueprintCallable, Category="MIDI")
+    void RefreshBindings();
+
+    virtual void OnRegister() override;
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+    // Resolved form of Bindings[i]
+    struct FResolved
+    {
+        FMidiControlHandle Handle;
+        int32 Collection = INDEX_NONE;  // into Collections
+        FName NiagaraName;              // "User.<Parameter>"; None for MPC bindings
+        float Applied = TNumericLimits<float>::Max();
+    };
+
+    TArray<FResolved> Resolved;
+    TArray<TWeakObjectPtr<UMaterialParameterCollectionInstance>> Collections;
+
+    // Niagara, or the owner's first Niagara component; Niagara itself is never written
+    UPROPERTY(Transient)
+    TObjectPtr<UNiagaraComponent> ResolvedNiagara;
+};
@@ -0,0 +1,18 @@
+using UnrealBuildTool;
+
+public class UnrealMidiFX : ModuleRules
+{
+    public UnrealMidiFX(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(new[] {
+            "Core", "CoreUObject", "Engine",
+            "UnrealMidi",
+        });
+
+        PrivateDependencyModuleNames.AddRange(new[] {
+            "Niagara",
+        });
+    }
+}
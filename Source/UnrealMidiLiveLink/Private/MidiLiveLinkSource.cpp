@@ -0,0 +1,156 @@
+#include "MidiLiveLinkSource.h"
+#include "ILiveLinkClient.h"
+#include "Roles/LiveLinkBasicRole.h"
+#include "Roles/LiveLinkBasicTypes.h"
+#include "UnrealMidiSubsystem.h"
+#include "Engine/Engine.h"
+#include "HAL/PlatformProcess.h"
+
+#define LOCTEXT_NAMESPACE "MidiLiveLinkSource"
+
+FMidiLiveLinkSource::~FMidiLiveLinkSource()
+{
+    Unbind();
+}
+
+void FMidiLiveLinkSource::ReceiveClient(ILiveLinkClient* InClient, FGuid InSourceGuid)
+{
+    Client = InClient;
+    SourceGuid = InSourceGuid;
+
+    UUnrealMidiSubsystem* Subsystem = GEngine ? GEngine->GetEngineSubsystem<UUnrealMidiSubsystem>() : nullptr;
+    if (!Subsystem)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[UnrealMidi] Live Link: no UnrealMidi subsystem, source stays empty"));
+        return;
+    }
+
+    Midi = Subsystem;
+    ValueHandle = Subsystem->OnMidiValueNative.AddRaw(this, &FMidiLiveLinkSource::HandleValue);
+    DisconnectHandle = Subsystem->OnDeviceDisconnected.AddRaw(this, &FMidiLiveLinkSource::HandleDisconnected);
+    TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMidiLiveLinkSource::Tick));
+}
+
+bool FMidiLiveLinkSource::IsSourceStillValid() const
+{
+    return Client != nullptr && Midi.IsValid();
+}
+
+bool FMidiLiveLinkSource::RequestSourceShutdown()
+{
+    Unbind();
+    Client = nullptr;
+    Subjects.Reset();
+    return true;
+}
+
+void FMidiLiveLinkSource::Unbind()
+{
+    if (UUnrealMidiSubsystem* Subsystem = Midi.Get())
+    {
+        Subsystem->OnMidiValueNative.Remove(ValueHandle);
+        Subsystem->OnDeviceDisconnected.Remove(DisconnectHandle);
+    }
+    Midi.Reset();
+
+    if (TickHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+        TickHandle.Reset();
+    }
+}
+
+FText FMidiLiveLinkSource::GetSourceType() const
+{
+    return LOCTEXT("SourceType", "MIDI");
+}
+
+FText FMidiLiveLinkSource::GetSourceMachineName() const
+{
+    return FText::FromString(FPlatformProcess::ComputerName());
+}
+
+FText FMidiLiveLinkSource::GetSourceStatus() const
+{
+    return Midi.IsValid()
+        ? FText::Format(LOCTEXT("Active", "{0} device(s)"), Subjects.Num())
+        : LOCTEXT("NoSubsystem", "No UnrealMidi subsystem");
+}
+
+void FMidiLiveLinkSource::HandleValue(const FMidiControlValue& V)
+{
+    // Relative ticks are deltas, not a state a subject could hold
+    if (V.bRelative || V.Type == EMidiMessageType::PC || V.Device.IsEmpty())
+        return;
+
+    // IN:<Device>:<TYPE>:<Chan>:<Num> -> TYPE_Chan_Num
+    TArray<FString> Parts;
+    V.Id.ParseIntoArray(Parts, TEXT(":"), false);
+    if (Parts.Num() < 5)
+        return;
+
+    FSubject& S = Subjects.FindOrAdd(V.Device);
+    if (S.Name.IsNone())
+        S.Name = FName(*V.Device);
+
+    int32 Index;
+    if (const int32* Found = S.PropertyOfId.Find(V.Id))
+    {
+        Index = *Found;
+    }
+    else
+    {
+        const int32 N = Parts.Num();
+        Index = S.PropertyNames.Add(FName(*FString::Printf(TEXT("%s_%s_%s"), *Parts[N - 3], *Parts[N - 2], *Parts[N - 1])));
+        S.Values.Add(0.f);
+        S.PropertyOfId.Add(V.Id, Index);
+        S.bStaticDirty = true;
+    }
+
+    S.Values[Index] = V.Value;
+    S.DriverTime = FMath::Max(S.DriverTime, V.Stages.Driver > 0.0 ? V.Stages.Driver : V.Stages.Callback);
+    S.bFrameDirty = true;
+}
+
+void FMidiLiveLinkSource::HandleDisconnected(const FString& DeviceName)
+{
+    FSubject Removed;
+    if (Client && Subjects.RemoveAndCopyValue(DeviceName, Removed))
+        Client->RemoveSubject_AnyThread(FLiveLinkSubjectKey(SourceGuid, Removed.Name));
+}
+
+bool FMidiLiveLinkSource::Tick(float DeltaTime)
+{
+    if (!Client)
+        return true;
+
+    for (TPair<FString, FSubject>& Kvp : Subjects)
+    {
+        FSubject& S = Kvp.Value;
+        if (!S.bFrameDirty)
+            continue;
+
+        const FLiveLinkSubjectKey Key(SourceGuid, S.Name);
+        if (S.bStaticDirty)
+        {
+            FLiveLinkStaticDataStruct Static(FLiveLinkBaseStaticData::StaticStruct());
+            Static.Cast<FLiveLinkBaseStaticData>()->PropertyNames = S.PropertyNames;
+            Client->PushSubjectStaticData_AnyThread(Key, ULiveLinkBasicRole::StaticClass(), MoveTemp(Static));
+            S.bStaticDirty = false;
+        }
+
+        // World time is the driver clock (FPlatformTime), so Live Link buffers and interpolates on when
+        // the controller sent the value, not when the game thread got to it
+        FLiveLinkFrameDataStruct Frame(FLiveLinkBaseFrameData::StaticStruct());
+        FLiveLinkBaseFrameData& Data = *Frame.Cast<FLiveLinkBaseFrameData>();
+        Data.WorldTime = FLiveLinkWorldTime(S.DriverTime);
+        Data.PropertyValues = S.Values;
+        Client->PushSubjectFrameData_AnyThread(Key, MoveTemp(Frame));
+
+        S.bFrameDirty = false;
+        S.DriverTime = 0.0;
+    }
+    return true;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,55 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "ILiveLinkSource.h"
+#include "Containers/Ticker.h"
+#include "MidiTypes.h"
+
+class ILiveLinkClient;
+class UUnrealMidiSubsystem;
+
+/**
+ * One Basic-role subject per MIDI input (named after the device), one float property per control
+ * ("CC_1_74", "NOTE_10_36"). A control becomes a property the first time it moves; that republishes the
+ * static data. Values are collected from the subsystem's dispatched (coalesced) batches and each changed
+ * device pushes one frame per engine frame, stamped with the newest driver timestamp it contains.
+ */
+class FMidiLiveLinkSource : public ILiveLinkSource
+{
+public:
+    virtual ~FMidiLiveLinkSource() override;
+
+    virtual void ReceiveClient(ILiveLinkClient* InClient, FGuid InSourceGuid) override;
+    virtual bool IsSourceStillValid() const override;
+    virtual bool RequestSourceShutdown() override;
+
+    virtual FText GetSourceType() const override;
+    virtual FText GetSourceMachineName() const override;
+    virtual FText GetSourceStatus() const override;
+
+private:
+    struct FSubject
+    {
+        FName Name;
+        TMap<FString, int32> PropertyOfId;
+        TArray<FName> PropertyNames;
+        TArray<float> Values;
+        double DriverTime = 0.0;    // newest driver timestamp since the last push
+        bool bStaticDirty = true;
+        bool bFrameDirty = false;
+    };
+
+    void HandleValue(const FMidiControlValue& V);
+    void HandleDisconnected(const FString& DeviceName);
+    bool Tick(float DeltaTime);
+    void Unbind();
+
+    ILiveLinkClient* Client = nullptr;
+    FGuid SourceGuid;
+
+    TWeakObjectPtr<UUnrealMidiSubsystem> Midi;
+    FDelegateHandle ValueHandle;
+    FDelegateHandle DisconnectHandle;
+    FTSTicker::FDelegateHandle TickHandle;
+
+    TMap<FString, FSubject> Subjects;   // by device name; game thread only
+};
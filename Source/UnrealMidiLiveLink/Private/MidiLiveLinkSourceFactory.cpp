@@ -0,0 +1,21 @@
+#include "MidiLiveLinkSourceFactory.h"
+#include "MidiLiveLinkSource.h"
+
+#define LOCTEXT_NAMESPACE "MidiLiveLinkSourceFactory"
+
+FText UMidiLiveLinkSourceFactory::GetSourceDisplayName() const
+{
+    return LOCTEXT("DisplayName", "MIDI");
+}
+
+FText UMidiLiveLinkSourceFactory::GetSourceTooltip() const
+{
+    return LOCTEXT("Tooltip", "Publishes every open MIDI input as a Basic subject, one property per control.");
+}
+
+TSharedPtr<ILiveLinkSource> UMidiLiveLinkSourceFactory::CreateSource(const FString& ConnectionString) const
+{
+    return MakeShared<FMidiLiveLinkSource>();
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,17 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "LiveLinkSourceFactory.h"
+#include "MidiLiveLinkSourceFactory.generated.h"
+
+/** "MIDI" entry of the Live Link panel's Add Source menu: one source for all open MIDI inputs */
+UCLASS()
+class UNREALMIDILIVELINK_API UMidiLiveLinkSourceFactory : public ULiveLinkSourceFactory
+{
+    GENERATED_BODY()
+
+public:
+    virtual FText GetSourceDisplayName() const override;
+    virtual FText GetSourceTooltip() const override;
+    virtual EMenuType GetMenuType() const override { return EMenuType::MenuEntry; }
+    virtual TSharedPtr<ILiveLinkSource> CreateSource(const FString& ConnectionString) const override;
+};
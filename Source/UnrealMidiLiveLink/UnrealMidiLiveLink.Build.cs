@@ -0,0 +1,19 @@
+using UnrealBuildTool;
+
+public class UnrealMidiLiveLink : ModuleRules
+{
+    public UnrealMidiLiveLink(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(new[] {
+            "Core", "CoreUObject", "Engine",
+            "LiveLinkInterface",
+        });
+
+        PrivateDependencyModuleNames.AddRange(new[] {
+            "Slate", "SlateCore",
+            "UnrealMidi",
+        });
+    }
+}
@@ -0,0 +1,229 @@
+#include "MetasoundExecutableOperator.h"
+#include "MetasoundFacade.h"
+#include "MetasoundNodeRegistrationMacro.h"
+#include "MetasoundParamHelper.h"
+#include "MetasoundPrimitives.h"
+#include "MetasoundTrigger.h"
+#include "MetasoundVertex.h"
+#include "Engine/Engine.h"
+#include "UnrealMidiSubsystem.h"
+
+#define LOCTEXT_NAMESPACE "UnrealMidiMetaSound"
+
+namespace Metasound
+{
+    namespace MidiNoteNode
+    {
+        METASOUND_PARAM(InDevice, "Device", "MIDI input name, as in the device picker. Read when the sound starts.");
+        METASOUND_PARAM(InChannel, "Channel", "1..16 (0 = any channel).");
+        METASOUND_PARAM(InNote, "Note", "Note number (-1 = any note).");
+        METASOUND_PARAM(OutNoteOn, "On", "Triggers at the note-on, at the sample offset of its driver timestamp.");
+        METASOUND_PARAM(OutNoteOff, "Off", "Triggers at the note-off.");
+        METASOUND_PARAM(OutNoteNumber, "Note Number", "Note of the last event.");
+        METASOUND_PARAM(OutVelocity, "Velocity", "Velocity of the last note-on, 0..1.");
+
+        // Fixed latency: at least two blocks, enough to cover a mixer callback rendering several blocks at once
+        constexpr double MinLatencySeconds = 0.02;
+    }
+
+    /**
+     * Reads the device's event ring on the audio render thread. Blocks follow the sample clock: block k covers
+     * driver time [Anchor + k * BlockSeconds, + BlockSeconds), Latency behind the wall clock, and each event lands
+     * at (Time - BlockStart) * SampleRate. Pads keep their timing (a fixed latency) instead of the render
+     * thread's or the game thread's jitter. The anchor is taken from wall time once, and again only if
+     * rendering drifts from the timeline by more than the latency.
+     *
+     * The ring is resolved when the operator is built or reset, never on the render thread: the lookup takes
+     * the subsystem's lock and may allocate.
+     */
+    class FMidiNoteOperator : public TExecutableOperator<FMidiNoteOperator>
+    {
+    public:
+        static const FVertexInterface& GetVertexInterface()
+        {
+            using namespace MidiNoteNode;
+            static const FVertexInterface Interface(
+                FInputVertexInterface(
+                    TInputDataVertex<FString>(METASOUND_GET_PARAM_NAME_AND_METADATA(InDevice)),
+                    TInputDataVertex<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InChannel), 0),
+                    TInputDataVertex<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InNote), -1)
+                ),
+                FOutputVertexInterface(
+                    TOutputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutNoteOn)),
+                    TOutputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutNoteOff)),
+                    TOutputDataVertex<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutNoteNumber)),
+                    TOutputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutVelocity))
+                )
+            );
+            return Interface;
+        }
+
+        static const FNodeClassMetadata& GetNodeInfo()
+        {
+            auto MakeInfo = []()
+            {
+                FNodeClassMetadata Info;
+                Info.ClassName = { TEXT("UnrealMidi"), TEXT("MIDI Note"), TEXT("") };
+                Info.MajorVersion = 1;
+                Info.MinorVersion = 0;
+                Info.DisplayName = LOCTEXT("MidiNoteDisplayName", "MIDI Note");
+                Info.Description = LOCTEXT("MidiNoteDescription", "Triggers on MIDI note-on / note-off, sample-accurate to the driver timestamps.");
+                Info.Author = TEXT("ToucheToucan");
+                Info.DefaultInterface = GetVertexInterface();
+                Info.CategoryHierarchy = { LOCTEXT("MidiCategory", "MIDI") };
+                return Info;
+            };
+            static const FNodeClassMetadata Info = MakeInfo();
+            return Info;
+        }
+
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+        {
+            using namespace MidiNoteNode;
+            const FInputVertexInterfaceData& Inputs = InParams.InputData;
+            return MakeUnique<FMidiNoteOperator>(InParams.OperatorSettings,
+                Inputs.GetOrCreateDefaultDataReadReference<FString>(METASOUND_GET_PARAM_NAME(InDevice), InParams.OperatorSettings),
+                Inputs.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(InChannel), InParams.OperatorSettings),
+                Inputs.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(InNote), InParams.OperatorSettings));
+        }
+
+        FMidiNoteOperator(const FOperatorSettings& InSettings, const FStringReadRef& InDevice, const FInt32ReadRef& InChannel, const FInt32ReadRef& InNote)
+            : Device(InDevice)
+            , Channel(InChannel)
+            , Note(InNote)
+            , NoteOn(FTriggerWriteRef::CreateNew(InSettings))
+            , NoteOff(FTriggerWriteRef::CreateNew(InSettings))
+            , NoteNumber(FInt32WriteRef::CreateNew(0))
+            , Velocity(FFloatWriteRef::CreateNew(0.f))
+            , NumFrames(InSettings.GetNumFramesPerBlock())
+            , SampleRate(InSettings.GetSampleRate())
+        {
+            BlockSeconds = SampleRate > 0.0 ? NumFrames / SampleRate : 0.0;
+            Latency = FMath::Max(2.0 * BlockSeconds, MidiNoteNode::MinLatencySeconds);
+            ResolveRing();
+        }
+
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace MidiNoteNode;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InDevice), Device);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InChannel), Channel);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InNote), Note);
+        }
+
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace MidiNoteNode;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutNoteOn), NoteOn);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutNoteOff), NoteOff);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutNoteNumber), NoteNumber);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutVelocity), Velocity);
+        }
+
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            NoteOn->Reset();
+            NoteOff->Reset();
+            *NoteNumber = 0;
+            *Velocity = 0.f;
+            Anchor = 0.0;
+            BlockIndex = 0;
+            ResolveRing();
+        }
+
+        void Execute()
+        {
+            NoteOn->AdvanceBlock();
+            NoteOff->AdvanceBlock();
+
+            if (BlockSeconds <= 0.0)
+                return;
+
+            // Re-anchor on the first block, or when rendering stalled / ran ahead past what the latency absorbs
+            const double Now = FPlatformTime::Seconds();
+            double BlockStart = Anchor + double(BlockIndex) * BlockSeconds;
+            if (Anchor <= 0.0 || FMath::Abs(Now - Latency - BlockStart) > Latency)
+            {
+                Anchor = Now - Latency;
+                BlockIndex = 0;
+                BlockStart = Anchor;
+            }
+            const double BlockEnd = BlockStart + BlockSeconds;
+            ++BlockIndex;
+
+            if (!Ring)
+                return;
+
+            FMidiTimedEvent Events[64];
+            int32 Num;
+            do
+            {
+                Num = Ring->Read(Cursor, BlockEnd, Events, UE_ARRAY_COUNT(Events));
+                for (int32 i = 0; i < Num; ++i)
+                {
+                    const FMidiTimedEvent& E = Events[i];
+                    if (E.Kind == FMidiTimedEvent::EKind::Cc)
+                        continue;
+                    if ((*Channel > 0 && E.Channel != *Channel) || (*Note >= 0 && E.Number != *Note))
+                        continue;
+
+                    // Late events (before the block, e.g. after a re-anchor) land on the first frame
+                    const int32 Frame = FMath::Clamp(int32((E.Time - BlockStart) * SampleRate), 0, NumFrames - 1);
+
+                    *NoteNumber = E.Number;
+                    if (E.Kind == FMidiTimedEvent::EKind::NoteOn)
+                    {
+                        *Velocity = E.Value;
+                        NoteOn->TriggerFrame(Frame);
+                    }
+                    else
+                    {
+                        NoteOff->TriggerFrame(Frame);
+                    }
+                }
+            }
+            while (Num == UE_ARRAY_COUNT(Events));
+        }
+
+    private:
+        void ResolveRing()
+        {
+            UUnrealMidiSubsystem* Midi = GEngine ? GEngine->GetEngineSubsystem<UUnrealMidiSubsystem>() : nullptr;
+            Ring = Midi && !Device->IsEmpty() ? &Midi->GetEventRing(*Device) : nullptr;
+            Cursor = Ring ? Ring->GetWriteCount() : 0;
+        }
+
+        FStringReadRef Device;
+        FInt32ReadRef Channel;
+        FInt32ReadRef Note;
+
+        FTriggerWriteRef NoteOn;
+        FTriggerWriteRef NoteOff;
+        FInt32WriteRef NoteNumber;
+        FFloatWriteRef Velocity;
+
+        int32 NumFrames = 0;
+        const FMidiEventRing* Ring = nullptr;
+        uint64 Cursor = 0;
+
+        // Block timeline (driver time)
+        double SampleRate = 0.0;
+        double BlockSeconds = 0.0;
+        double Latency = 0.0;
+        double Anchor = 0.0;
+        int64 BlockIndex = 0;
+    };
+
+    class FMidiNoteNode : public FNodeFacade
+    {
+    public:
+        FMidiNoteNode(const FNodeInitData& InitData)
+            : FNodeFacade(InitData.InstanceName, InitData.InstanceID, TFacadeOperatorClass<FMidiNoteOperator>())
+        {
+        }
+    };
+
+    METASOUND_REGISTER_NODE(FMidiNoteNode)
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,14 @@
+#include "Modules/ModuleManager.h"
+#include "MetasoundFrontendRegistries.h"
+
+class FUnrealMidiMetaSoundModule : public IModuleInterface
+{
+public:
+    virtual void StartupModule() override
+    {
+        // Nodes declared with METASOUND_REGISTER_NODE in this module
+        FMetasoundFrontendRegistryContainer::Get()->RegisterPendingNodes();
+    }
+};
+
+IMPLEMENT_MODULE(FUnrealMidiMetaSoundModule, UnrealMidiMetaSound)
@@ -0,0 +1,15 @@
+using UnrealBuildTool;
+
+public class UnrealMidiMetaSound : ModuleRules
+{
+    public UnrealMidiMetaSound(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PrivateDependencyModuleNames.AddRange(new[] {
+            "Core", "CoreUObject", "Engine",
+            "MetasoundGraphCore", "MetasoundFrontend",
+            "UnrealMidi",
+        });
+    }
+}